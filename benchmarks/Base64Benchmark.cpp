@@ -0,0 +1,50 @@
+// Base64 kernels and byte-buffer fields against the integer-array encoding they replace.
+// Built twice, with the SIMD kernels and with NAYAN_SERIALIZER_DISABLE_SIMD.
+
+#include "BenchmarkSupport.h"
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+
+int main() {
+    std::printf("base64: %s\n", Base64::Backend());
+    nayan::serializer::test::Random random(1);
+    Base64Bytes image(1 << 20);
+    for (UInt8& byte : image) {
+        byte = static_cast<UInt8>(random.Next());
+    }
+    StdString encoded(Base64::EncodedLength(image.size()), '\0');
+    StdVector<uint8_t> decoded(Base64::DecodedCapacity(encoded.size()));
+
+    Measure("Base64::Encode 1 MiB", image.size(), [&] {
+        Base64::Encode(image.data(), image.size(), &encoded[0]);
+        DoNotOptimize(encoded[0]);
+    });
+    Measure("Base64::Decode 1 MiB", image.size(), [&] {
+        size_t written = 0;
+        DoNotOptimize(Base64::Decode(encoded.data(), encoded.size(), decoded.data(), written));
+    });
+
+    // The same bytes as a field value: base64 string against a JSON array of integers
+    const StdVector<UInt8> plain(image.begin(), image.end());
+    const StdString base64Json = SerializationUtility::Serialize(image);
+    const StdString arrayJson = SerializationUtility::Serialize(plain);
+    std::printf("1 MiB buffer: base64 %zu bytes, integer array %zu bytes\n", base64Json.size(), arrayJson.size());
+    Measure("Serialize Base64Bytes", image.size(), [&] {
+        DoNotOptimize(SerializationUtility::Serialize(image));
+    });
+    Measure("Serialize StdVector<UInt8>", image.size(), [&] {
+        DoNotOptimize(SerializationUtility::Serialize(plain));
+    });
+    Measure("TryDeserialize Base64Bytes", image.size(), [&] {
+        Base64Bytes out;
+        DoNotOptimize(SerializationUtility::TryDeserialize(base64Json, out).error);
+    });
+    Measure("TryDeserialize StdVector<UInt8>", image.size(), [&] {
+        StdVector<UInt8> out;
+        DoNotOptimize(SerializationUtility::TryDeserialize(arrayJson, out).error);
+    });
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef SERIALIZATIONLIB_BENCHMARK_SUPPORT_H
+#define SERIALIZATIONLIB_BENCHMARK_SUPPORT_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Minimal benchmark harness: runs an operation until it has taken at least the minimum time
+ * (NAYAN_BENCHMARK_MIN_SECONDS in the environment, 0.5 s by default) and prints time per
+ * operation and throughput.
+ *
+ *   Measure("parse", json.size(), [&] { DoNotOptimize(Project::Deserialize(json)); });
+ */
+
+namespace nayan {
+namespace serializer {
+namespace benchmark {
+
+/**
+ * Keep the compiler from discarding a result that is otherwise unused.
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline double MinSeconds() {
+    const char* text = std::getenv("NAYAN_BENCHMARK_MIN_SECONDS");
+    double seconds = text != nullptr ? std::atof(text) : 0.0;
+    return seconds > 0.0 ? seconds : 0.5;
+}
+
+/**
+ * Time `operation` and print one result line.
+ *
+ * @param name Label of the result line
+ * @param bytes Bytes processed by one call (0 to omit the throughput)
+ * @param operation The code to measure
+ * @return Nanoseconds per call
+ */
+template<typename Operation>
+double Measure(const char* name, size_t bytes, Operation operation) {
+    using Clock = std::chrono::steady_clock;
+    operation();  // Warm up caches and lazily selected kernels
+    const double minSeconds = MinSeconds();
+    size_t iterations = 1;
+    double seconds = 0.0;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            operation();
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minSeconds) {
+            break;
+        }
+        iterations *= seconds > minSeconds / 10 ? 2 : 10;
+    }
+    double nanosPerOperation = seconds * 1e9 / static_cast<double>(iterations);
+    if (bytes != 0) {
+        double megabytesPerSecond = static_cast<double>(bytes) * static_cast<double>(iterations) / seconds / 1e6;
+        std::printf("%-44s %12.0f ns/op %10.1f MB/s\n", name, nanosPerOperation, megabytesPerSecond);
+    } else {
+        std::printf("%-44s %12.0f ns/op\n", name, nanosPerOperation);
+    }
+    return nanosPerOperation;
+}
+
+} // namespace benchmark
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATIONLIB_BENCHMARK_SUPPORT_H
@@ -0,0 +1,43 @@
+// Wire size and throughput of MessagePack against JSON for a small DTO (the
+// inter-service case: many small messages) and for a large one.
+
+#include "BenchmarkSupport.h"
+#include "SampleData.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+using namespace nayan::serializer::test;
+
+template<typename T>
+static void run(const char* label, const T& value) {
+    const StdString json = SerializationUtility::Serialize(value);
+    const StdString msgpack = SerializationUtility::SerializeMsgPack(value);
+    std::printf("%s: JSON %zu bytes, MessagePack %zu bytes (%.0f%% smaller)\n", label, json.size(), msgpack.size(),
+                100.0 * (1.0 - static_cast<double>(msgpack.size()) / static_cast<double>(json.size())));
+
+    StdString output;
+    Measure("  serialize JSON", json.size(), [&] {
+        output.clear();
+        SerializationUtility::Serialize(value, output);
+        DoNotOptimize(output.size());
+    });
+    Measure("  serialize MessagePack", msgpack.size(), [&] {
+        output.clear();
+        SerializationUtility::SerializeMsgPack(value, output);
+        DoNotOptimize(output.size());
+    });
+    Measure("  deserialize JSON", json.size(), [&] {
+        T out;
+        DoNotOptimize(SerializationUtility::TryDeserialize(json, out).error);
+    });
+    Measure("  deserialize MessagePack", msgpack.size(), [&] {
+        T out;
+        DoNotOptimize(SerializationUtility::TryDeserializeMsgPack(msgpack, out).error);
+    });
+}
+
+int main() {
+    run("Task", MakeTask(6));
+    run("Project with 200 tasks", MakeProject(200));
+    return 0;
+}
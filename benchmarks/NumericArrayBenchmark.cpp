@@ -0,0 +1,74 @@
+// 100k-sample numeric arrays through the contiguous fast path (StdVector) and the
+// element-by-element path (std::list), and through the ArduinoJson document.
+
+#include <list>
+#include "BenchmarkSupport.h"
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+
+template<typename T>
+static void run(const char* label, const StdVector<T>& samples) {
+    const StdString json = SerializationUtility::Serialize(samples);
+    const std::list<T> list(samples.begin(), samples.end());
+    std::printf("%s: %zu samples, %zu bytes\n", label, samples.size(), json.size());
+
+    Measure("  write StdVector (fast path)", json.size(), [&] {
+        DoNotOptimize(SerializationUtility::Serialize(samples));
+    });
+    Measure("  write std::list (per element)", json.size(), [&] {
+        DoNotOptimize(SerializationUtility::Serialize(list));
+    });
+    Measure("  read StdVector (fast path)", json.size(), [&] {
+        StdVector<T> out;
+        DoNotOptimize(SerializationUtility::TryDeserialize(json, out).error);
+    });
+    Measure("  read std::list (per element)", json.size(), [&] {
+        std::list<T> out;
+        DoNotOptimize(SerializationUtility::TryDeserialize(json, out).error);
+    });
+
+    // The document path the fast path replaced
+    JsonDocument check;
+    deserializeJson(check, json.data(), json.size());
+    if (check.as<JsonArrayConst>().size() != samples.size()) {
+        std::printf("  %-42s skipped: this ArduinoJson build does not parse the input\n", "ArduinoJson document");
+        return;
+    }
+    Measure("  write ArduinoJson document", json.size(), [&] {
+        JsonDocument doc;
+        JsonArray array = doc.to<JsonArray>();
+        for (T value : samples) {
+            array.add(value);
+        }
+        StdString out;
+        serializeJson(doc, out);
+        DoNotOptimize(out);
+    });
+    Measure("  read ArduinoJson document", json.size(), [&] {
+        JsonDocument doc;
+        deserializeJson(doc, json.data(), json.size());
+        StdVector<T> out;
+        for (JsonVariantConst element : doc.as<JsonArrayConst>()) {
+            out.push_back(element.as<T>());
+        }
+        DoNotOptimize(out.size());
+    });
+}
+
+int main() {
+    nayan::serializer::test::Random random(1);
+    StdVector<int> integers(100000);
+    for (int& value : integers) {
+        value = static_cast<int>(random.Next() % 2000001) - 1000000;
+    }
+    StdVector<double> doubles(100000);
+    for (double& value : doubles) {
+        value = static_cast<double>(random.Next() % 1000000) / 997.0;
+    }
+    run("StdVector<int>", integers);
+    run("StdVector<double>", doubles);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// NumericConversionUtility against the ostringstream / std::stoll / std::stod
+// conversions it replaced. Also built with NAYAN_SERIALIZER_FLOAT_CHARCONV=0 for the fallback.
+
+#include <sstream>
+#include <NumericConversionUtility.h>
+#include "BenchmarkSupport.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+
+// The previous convert_primitive_to_string / convert_string_to_primitive
+template<typename T>
+static StdString format_with_stream(T value) {
+    std::ostringstream stream;
+    stream << value;
+    return StdString(stream.str());
+}
+
+template<typename T>
+static T parse_with_std(const StdString& text) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<T>(std::stoll(text));
+    } else {
+        return static_cast<T>(std::stod(text));
+    }
+}
+
+template<typename T>
+static void run(const char* label, const StdVector<T>& values) {
+    StdVector<StdString> texts;
+    size_t bytes = 0;
+    for (T value : values) {
+        StdString text;
+        NumericConversionUtility::AppendNumber(value, text);
+        bytes += text.size();
+        texts.push_back(text);
+    }
+    std::printf("%s: %zu values\n", label, values.size());
+
+    Measure("  format ostringstream", bytes, [&] {
+        for (T value : values) {
+            DoNotOptimize(format_with_stream(value));
+        }
+    });
+    Measure("  format NumericConversionUtility", bytes, [&] {
+        char buffer[NumericConversionUtility::MaxFormattedLength];
+        for (T value : values) {
+            size_t length = 0;
+            NumericConversionUtility::FormatNumber(value, buffer, sizeof(buffer), length);
+            DoNotOptimize(buffer[0]);
+        }
+    });
+    Measure("  parse std::stoll / std::stod", bytes, [&] {
+        for (const StdString& text : texts) {
+            DoNotOptimize(parse_with_std<T>(text));
+        }
+    });
+    Measure("  parse NumericConversionUtility", bytes, [&] {
+        for (const StdString& text : texts) {
+            T value{};
+            NumericConversionUtility::ParseNumber(text.data(), text.data() + text.size(), value);
+            DoNotOptimize(value);
+        }
+    });
+}
+
+int main() {
+    std::printf("floating point charconv: %d\n", NAYAN_SERIALIZER_FLOAT_CHARCONV);
+    nayan::serializer::test::Random random(3);
+    StdVector<long> integers(100000);
+    for (long& value : integers) {
+        value = static_cast<long>(random.Next() >> random.Below(64));
+    }
+    StdVector<double> doubles(100000);
+    for (double& value : doubles) {
+        value = static_cast<double>(static_cast<long>(random.Next() % 2000000) - 1000000) / 7.0;
+    }
+    run("long", integers);
+    run("double", doubles);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Escaping and unescaping string content. Built twice, with the SIMD scanners and with
+// NAYAN_SERIALIZER_DISABLE_SIMD, and compared with a byte-by-byte escaper.
+
+#include "BenchmarkSupport.h"
+#include "SampleData.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+using namespace nayan::serializer::test;
+
+// Log-line-like strings; every `specialEvery`-th one contains a quote and a newline
+static StdVector<StdString> make_lines(size_t count, size_t specialEvery) {
+    StdVector<StdString> lines;
+    for (size_t i = 0; i < count; ++i) {
+        StdString line = "2024-05-01T12:00:00Z INFO request " + std::to_string(i) +
+                         " served /api/v1/items?page=3 in 12ms by worker-7 (cache hit, 2048 bytes)";
+        if (specialEvery != 0 && i % specialEvery == 0) {
+            line += " \"quoted\"\n\tdetail";
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// One character at a time, as the writer did before the scanners
+static void escape_bytewise(const StdString& text, StdString& out) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (char c : text) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (byte < 0x20) {
+            out += "\\u00";
+            out += hex[byte >> 4];
+            out += hex[byte & 15];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+static void run(const char* label, const StdVector<StdString>& lines) {
+    size_t bytes = 0;
+    for (const StdString& line : lines) {
+        bytes += line.size();
+    }
+    StdString json = SerializationUtility::Serialize(lines);
+    std::printf("%s: %zu strings, %zu bytes\n", label, lines.size(), bytes);
+
+    StdString out;
+    out.reserve(json.size() * 2);
+    Measure("  byte-by-byte escape", bytes, [&] {
+        out.clear();
+        for (const StdString& line : lines) {
+            escape_bytewise(line, out);
+        }
+        DoNotOptimize(out.size());
+    });
+    Measure("  JsonWriter::WriteString", bytes, [&] {
+        out.clear();
+        JsonWriter<StdString> writer(out);
+        for (const StdString& line : lines) {
+            writer.WriteString(line.data(), line.size());
+        }
+        DoNotOptimize(out.size());
+    });
+    Measure("  TryDeserialize StdVector<StdString>", bytes, [&] {
+        StdVector<StdString> back;
+        DoNotOptimize(SerializationUtility::TryDeserialize(json, back).error);
+    });
+}
+
+int main() {
+    std::printf("string scanner: %s\n", StringScanner::Backend());
+    run("plain", make_lines(20000, 0));
+    run("one in ten with escapes", make_lines(20000, 10));
+    run("all with escapes", make_lines(20000, 1));
+    return 0;
+}
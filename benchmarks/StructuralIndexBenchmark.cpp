@@ -0,0 +1,64 @@
+// Deserializing a large StdVector<Project> corpus through the generated pull parser with
+// and without the structural index, against the ArduinoJson document path on the same corpus.
+
+#include "BenchmarkSupport.h"
+#include "SampleData.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::benchmark;
+using namespace nayan::serializer::test;
+
+int main() {
+    StdVector<Project> corpus;
+    for (size_t i = 0; i < 200; ++i) {
+        corpus.push_back(MakeProject(40));
+    }
+    const StdString json = SerializationUtility::Serialize(corpus);
+    std::printf("corpus: %zu projects, %zu bytes\n", corpus.size(), json.size());
+
+    JsonStructuralIndex index;
+    Measure("JsonStructuralIndex::Build", json.size(), [&] {
+        index.Build(json.data(), json.size());
+        DoNotOptimize(index.Count());
+    });
+    std::printf("  backend %s, %zu quote positions\n", JsonStructuralIndex::Backend(), index.Count());
+
+    Measure("JsonReader without index", json.size(), [&] {
+        StdVector<Project> out;
+        JsonReader reader(json.data(), json.size());
+        DoNotOptimize(SerializationUtility::Read(reader, out).error);
+    });
+    Measure("JsonReader with prebuilt index", json.size(), [&] {
+        StdVector<Project> out;
+        JsonReader reader(json.data(), json.size(), index);
+        DoNotOptimize(SerializationUtility::Read(reader, out).error);
+    });
+    // What TryDeserialize does above a nonzero NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD
+    Measure("JsonReader building its index", json.size(), [&] {
+        JsonStructuralIndex built;
+        built.Build(json.data(), json.size());
+        StdVector<Project> out;
+        JsonReader reader(json.data(), json.size(), built);
+        DoNotOptimize(SerializationUtility::Read(reader, out).error);
+    });
+
+    // The document path the generated parser replaced: deserializeJson + FromJson per element
+    JsonDocument check;
+    deserializeJson(check, json.data(), json.size());
+    JsonArrayConst array = check.as<JsonArrayConst>();
+    Project first;
+    if (array.size() != corpus.size() || !Project::TryFromJson(array[0], first) || ToJson(first) != ToJson(corpus[0])) {
+        std::printf("%-44s skipped: this ArduinoJson build does not parse the corpus\n", "ArduinoJson deserializeJson + TryFromJson");
+        return 0;
+    }
+    Measure("ArduinoJson deserializeJson + TryFromJson", json.size(), [&] {
+        JsonDocument doc;
+        deserializeJson(doc, json.data(), json.size());
+        StdVector<Project> out;
+        for (JsonVariantConst element : doc.as<JsonArrayConst>()) {
+            out.emplace_back();
+            DoNotOptimize(Project::TryFromJson(element, out.back()).error);
+        }
+    });
+    return 0;
+}
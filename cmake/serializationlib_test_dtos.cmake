@@ -0,0 +1,45 @@
+# Generates the DTOs shared by the tests and benchmarks
+# The annotated headers in tests/dto/*.h.in are copied into the build tree and run through the
+# same pre-build pipeline as client code, so the sources stay untouched and the generated code
+# is exactly what a client would get.
+# Provides the INTERFACE target serializationlib_test_dtos.
+
+if(TARGET serializationlib_test_dtos)
+    return()
+endif()
+
+set(SERIALIZATIONLIB_TEST_DTO_DIR ${CMAKE_BINARY_DIR}/serializationlib_test_dtos)
+file(REMOVE_RECURSE ${SERIALIZATIONLIB_TEST_DTO_DIR})
+file(MAKE_DIRECTORY ${SERIALIZATIONLIB_TEST_DTO_DIR})
+
+file(GLOB SERIALIZATIONLIB_TEST_DTO_SOURCES ${CMAKE_CURRENT_LIST_DIR}/../tests/dto/*.h.in)
+foreach(dto_source ${SERIALIZATIONLIB_TEST_DTO_SOURCES})
+    get_filename_component(dto_name ${dto_source} NAME)
+    string(REGEX REPLACE "\\.in$" "" dto_name ${dto_name})
+    # configure_file (not file(COPY)) so an edited DTO re-runs the generation
+    configure_file(${dto_source} ${SERIALIZATIONLIB_TEST_DTO_DIR}/${dto_name} COPYONLY)
+endforeach()
+
+# Regenerate when the generator scripts change
+file(GLOB SERIALIZATIONLIB_GENERATOR_SCRIPTS
+    ${CMAKE_CURRENT_LIST_DIR}/../serializationlib_scripts/*.py
+    ${CMAKE_CURRENT_LIST_DIR}/../serializationlib_scripts/*/*.py
+)
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${SERIALIZATIONLIB_GENERATOR_SCRIPTS})
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E env "CMAKE_PROJECT_DIR=${SERIALIZATIONLIB_TEST_DTO_DIR}"
+        ${PYTHON_EXECUTABLE}
+        "${CMAKE_CURRENT_LIST_DIR}/../serializationlib_scripts/serializationlib_pre_build.py"
+    WORKING_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}/..
+    RESULT_VARIABLE SERIALIZATIONLIB_TEST_DTO_RESULT
+    OUTPUT_VARIABLE SERIALIZATIONLIB_TEST_DTO_OUTPUT
+    ERROR_VARIABLE SERIALIZATIONLIB_TEST_DTO_OUTPUT
+)
+if(NOT SERIALIZATIONLIB_TEST_DTO_RESULT EQUAL "0")
+    message(FATAL_ERROR "Generating the test DTOs failed:\n${SERIALIZATIONLIB_TEST_DTO_OUTPUT}")
+endif()
+
+add_library(serializationlib_test_dtos INTERFACE)
+target_include_directories(serializationlib_test_dtos INTERFACE ${SERIALIZATIONLIB_TEST_DTO_DIR})
+target_link_libraries(serializationlib_test_dtos INTERFACE serializationlib)
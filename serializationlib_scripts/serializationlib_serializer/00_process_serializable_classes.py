@@ -341,6 +341,10 @@ def process_all_serializable_classes(dry_run=False, serializable_macro=None):
                     # Inject code
                     success = S8_handle_enum_serialization.inject_enum_code(file_path, code, dry_run=False)
                     if success:
+                        # The includes added above move the annotation down; find it again before marking it
+                        current_info = S8_handle_enum_serialization.check_enum_annotation(file_path, serializable_macro)
+                        if current_info and current_info.get('has_enum'):
+                            annotation_line = current_info['annotation_line']
                         # Mark annotation as processed
                         S8_handle_enum_serialization.mark_enum_annotation_processed(file_path, annotation_line, dry_run=False)
                         processed_count += 1
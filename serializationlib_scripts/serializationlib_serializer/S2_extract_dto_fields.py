@@ -77,6 +77,7 @@ def extract_all_fields(file_path: str, class_name: str) -> List[Dict[str, str]]:
         
     Returns:
         List of dictionaries with 'type' and 'name' keys
+        (plus 'field_id' when the field carries a //@FieldId(n) annotation)
     """
     boundaries = find_class_boundaries(file_path, class_name)
     if not boundaries:
@@ -101,12 +102,22 @@ def extract_all_fields(file_path: str, class_name: str) -> List[Dict[str, str]]:
     access_pattern = r'^\s*(public|private|protected)\s*:'
     # Field pattern: matches "int a;" or "StdString name;"
     field_pattern = r'^\s*([A-Za-z_][A-Za-z0-9_<>*&,\s]*?)\s+([A-Za-z_][A-Za-z0-9_]*)\s*[;=]'
+    # Binary field id: //@FieldId(n) or /*@FieldId(n)*/ above the field or on the same line
+    field_id_pattern = r'@FieldId\s*\(\s*(\d+)\s*\)'
+    pending_field_id = None
     
     for line in class_lines:
         stripped = line.strip()
         
-        # Skip comments
-        if stripped.startswith('//') or stripped.startswith('/*'):
+        field_id_match = re.search(field_id_pattern, stripped)
+        # Declaration without annotations/comments (e.g. "/*@FieldId(2)*/ optional<int> count;")
+        declaration = re.sub(r'/\*.*?\*/', '', stripped)
+        declaration = re.sub(r'//.*$', '', declaration).strip()
+        
+        # Skip comments (remembering a field id annotation for the next field)
+        if stripped.startswith('//') or (stripped.startswith('/*') and not declaration):
+            if field_id_match:
+                pending_field_id = int(field_id_match.group(1))
             continue
         
         # Skip empty lines
@@ -121,16 +132,24 @@ def extract_all_fields(file_path: str, class_name: str) -> List[Dict[str, str]]:
         
         # Process all members (public, private, protected) - no access restriction
         # Check for member variable
-        field_match = re.search(field_pattern, stripped)
+        field_match = re.search(field_pattern, declaration)
         if field_match:
             field_type = field_match.group(1).strip()
             field_name = field_match.group(2).strip()
             # Skip if it looks like a method declaration (has parentheses) or is a keyword
-            if '(' not in stripped and ')' not in stripped and field_name not in ['public', 'private', 'protected']:
-                fields.append({
+            if '(' not in declaration and ')' not in declaration and field_name not in ['public', 'private', 'protected']:
+                field = {
                     'type': field_type,
                     'name': field_name
-                })
+                }
+                if field_id_match:
+                    field['field_id'] = int(field_id_match.group(1))
+                elif pending_field_id is not None:
+                    field['field_id'] = pending_field_id
+                fields.append(field)
+        
+        # A field id annotation only applies to the declaration right after it
+        pending_field_id = None
     
     return fields
 
@@ -152,9 +152,111 @@ def is_sequential_container_type(inner_type: str) -> bool:
     )
 
 
+def is_associative_container_type(inner_type: str) -> bool:
+    """
+    Check if the inner type is an associative container (map) from type string.
+    E.g., "StdMap<StdString, int>", "std::unordered_map<int, Foo>"
+    
+    Args:
+        inner_type: The inner type string (e.g. from extract_inner_type_from_optional)
+        
+    Returns:
+        True if the type looks like an associative container
+    """
+    inner = inner_type.strip()
+    return (
+        inner.startswith('StdMap<') or
+        inner.startswith('Map<') or
+        inner.startswith('std::map<') or
+        inner.startswith('StdUnorderedMap<') or
+        inner.startswith('UnorderedMap<') or
+        inner.startswith('std::unordered_map<')
+    )
+
+
+def is_base64_bytes_type(inner_type: str) -> bool:
+    """
+    Check if the inner type is a byte buffer written as a base64 string (see Base64.h).
+    E.g., "Base64Bytes", "nayan::serializer::Base64Array<32>"
+    
+    Args:
+        inner_type: The inner type string (e.g. from extract_inner_type_from_optional)
+        
+    Returns:
+        True if the type is Base64Bytes or Base64Array<N>
+    """
+    inner = inner_type.strip()
+    if inner.startswith('nayan::serializer::'):
+        inner = inner[len('nayan::serializer::'):]
+    return inner == 'Base64Bytes' or inner.startswith('Base64Array<')
+
+
+
+def field_name_hash(seed: int, name: str) -> int:
+    """
+    Seeded 32-bit FNV-1a hash of a field name.
+    Must stay identical to SerializationUtility::FieldNameHash, which generated FieldSlot calls.
+    """
+    value = (seed ^ 0x811C9DC5) & 0xFFFFFFFF
+    for byte in name.encode('utf-8'):
+        value ^= byte
+        value = (value * 0x01000193) & 0xFFFFFFFF
+    # Fold the high bits in: the low bits of FNV alone barely depend on the seed
+    return value ^ (value >> 16)
+
+
+def build_field_perfect_hash(names: List[str]) -> Dict[str, object]:
+    """
+    Compute a minimal perfect hash over the field names (hash and displace).
+    Names are grouped into buckets by an unseeded hash; the largest buckets are placed first by
+    searching a seed that sends all their names to free slots, single-name buckets take the
+    remaining slots directly (stored as -slot - 1).
+    
+    Args:
+        names: Distinct field names
+        
+    Returns:
+        Dictionary with 'displacements' (one entry per bucket) and 'slots' (field name per slot)
+    """
+    size = len(names)
+    displacements = [0] * size
+    slots = [None] * size
+    buckets = [[] for _ in range(size)]
+    for name in names:
+        buckets[field_name_hash(0, name) % size].append(name)
+    
+    for bucket in sorted(buckets, key=len, reverse=True):
+        if len(bucket) <= 1:
+            break
+        seed = 1
+        while True:
+            candidate = [field_name_hash(seed, name) % size for name in bucket]
+            if len(set(candidate)) == len(candidate) and all(slots[slot] is None for slot in candidate):
+                break
+            seed += 1
+            if seed > 0x7FFFFFFF:
+                raise ValueError(f"no perfect hash seed found for fields {bucket}")
+        displacements[field_name_hash(0, bucket[0]) % size] = seed
+        for name, slot in zip(bucket, candidate):
+            slots[slot] = name
+    
+    free_slots = [slot for slot in range(size) if slots[slot] is None]
+    for bucket in buckets:
+        if len(bucket) == 1:
+            slot = free_slots.pop()
+            displacements[field_name_hash(0, bucket[0]) % size] = -slot - 1
+            slots[slot] = bucket[0]
+    
+    # The emitted lookup must find every field in its own slot
+    for name in names:
+        displacement = displacements[field_name_hash(0, name) % size]
+        slot = -displacement - 1 if displacement < 0 else field_name_hash(displacement, name) % size
+        assert slots[slot] == name, f"perfect hash lookup failed for field {name}"
+    return {'displacements': displacements, 'slots': slots}
+
 def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]], validation_fields_by_macro: Dict[str, List[Dict[str, str]]] = None) -> str:
     """
-    Generate Serialize() and Deserialize() methods for a Dto class.
+    Generate Serialize(), SerializeTo(), Deserialize() and FromJson() methods for a Dto class.
     
     Args:
         class_name: Name of the class
@@ -169,13 +271,85 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
         validation_fields_by_macro = {}
     code_lines = []
     
+    # Optional trailing parameter: the context supplies the allocator for every document the method creates
+    context_param = "const nayan::serializer::SerializationContext& context = nayan::serializer::SerializationContext::Default()"
+    
     # Generate Serialize() method
     code_lines.append("    // Serialization method")
     code_lines.append(f"    Public StdString Serialize() const {{")
-    code_lines.append("        // Create JSON document")
-    code_lines.append("        JsonDocument doc;")
+    code_lines.append("        StdString output;")
+    code_lines.append("        Serialize(output);")
+    code_lines.append("        return output;")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate append-mode Serialize(StdString&) method
+    code_lines.append("    // Append-mode serialization: writes straight into the caller's string without clearing it")
+    code_lines.append(f"    Public void Serialize(StdString& output, {context_param}) const {{")
+    code_lines.append("        // Written through a JsonWriter by WriteTo, no intermediate document")
+    code_lines.append("        nayan::serializer::SerializationUtility::Serialize(*this, output, context);")
+    code_lines.append("    }")
     code_lines.append("")
     
+    # Generate SerializedSize() method
+    code_lines.append("    // Exact length of the JSON produced by Serialize(), measured without producing output")
+    code_lines.append(f"    Public size_t SerializedSize({context_param}) const {{")
+    code_lines.append("        // Counted by WriteTo through a CountingWriter")
+    code_lines.append("        return nayan::serializer::SerializationUtility::MeasureSerialized(*this, context);")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate Serialize(char*, size_t) method
+    code_lines.append("    // Serialization into a caller-provided buffer: returns the length written, or 0 if it does not fit")
+    code_lines.append(f"    Public size_t Serialize(char* buffer, size_t capacity, {context_param}) const {{")
+    code_lines.append("        return nayan::serializer::SerializationUtility::Serialize(*this, buffer, capacity, context);")
+    code_lines.append("    }")
+    code_lines.append("")
+    code_lines.append("    // Streaming serialization into a Sink (OstreamSink, FdSink, CallbackSink): constant memory, returns false if the sink failed")
+    code_lines.append("    Public template<typename Sink, typename = std::enable_if_t<nayan::serializer::is_output_sink<Sink>::value>>")
+    code_lines.append("    bool Serialize(Sink& sink) const {")
+    code_lines.append("        return nayan::serializer::SerializationUtility::Serialize(*this, sink);")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate MessagePack serialization methods (same fields as JSON, written through a MsgPackWriter)
+    code_lines.append("    // MessagePack serialization method")
+    code_lines.append(f"    Public StdString SerializeMsgPack({context_param}) const {{")
+    code_lines.append("        StdString output;")
+    code_lines.append("        SerializeMsgPack(output, context);")
+    code_lines.append("        return output;")
+    code_lines.append("    }")
+    code_lines.append("")
+    code_lines.append("    // Append-mode MessagePack serialization")
+    code_lines.append(f"    Public void SerializeMsgPack(StdString& output, {context_param}) const {{")
+    code_lines.append("        nayan::serializer::SerializationUtility::SerializeMsgPack(*this, output, context);")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate WriteTo() method - every output format (JSON, MessagePack, size counting) is a Writer backend
+    optional_fields = [field for field in fields if is_optional_type(field['type'].strip())]
+    code_lines.append("    // Format-agnostic serialization: writes the fields through any Writer backend")
+    code_lines.append("    Public template<typename Writer>")
+    code_lines.append("    void WriteTo(Writer& writer) const {")
+    # The field count is known here, so MsgPackWriter writes the final map header up front
+    code_lines.append(f"        writer.BeginObject({len(optional_fields)});")
+    for field in optional_fields:
+        field_name = field['name']
+        # Empty optionals are written as null, like SerializeTo (out["field"] = nullptr)
+        code_lines.append(f"        writer.Key(\"{field_name}\", {len(field_name)});")
+        code_lines.append(f"        if ({field_name}.has_value()) {{")
+        code_lines.append(f"            nayan::serializer::SerializationUtility::Write(writer, {field_name}.value());")
+        code_lines.append("        } else {")
+        code_lines.append("            writer.WriteNull();")
+        code_lines.append("        }")
+    code_lines.append("        writer.EndObject();")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate SerializeTo() method - writes fields straight into a JSON object owned by the caller
+    code_lines.append("    // In-place serialization method (used for nested objects and container elements)")
+    code_lines.append(f"    Public void SerializeTo(JsonObject out) const {{")
+    
     # Only serialize optional fields - skip non-optional fields
     # Primitive types that can be serialized directly
     primitive_types = ['int', 'Int', 'CInt', 'long', 'Long', 'CLong', 'float', 'Float', 'CFloat', 
@@ -187,67 +361,40 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
     
     if not optional_fields:
         code_lines.append("        // No optional fields to serialize")
+        code_lines.append("        (void)out;")
     else:
         for field in optional_fields:
             field_type = field['type'].strip()
             field_name = field['name']
+            # Keys stay string literals: ArduinoJson 7.3+ already stores a literal key by pointer
             
             # Extract inner type
             inner_type = extract_inner_type_from_optional(field_type)
             
-            # Check inner type characteristics
-            is_primitive = any(prim in inner_type for prim in primitive_types)
-            is_string = 'StdString' in inner_type or 'CStdString' in inner_type or 'string' in inner_type.lower()
-            is_sequential = is_sequential_container_type(inner_type)
+            # Check inner type characteristics (containers first: their element types would match below)
+            is_container = is_sequential_container_type(inner_type) or is_associative_container_type(inner_type)
+            is_string = not is_container and ('StdString' in inner_type or 'CStdString' in inner_type or 'string' in inner_type.lower())
+            is_primitive = not is_container and any(prim in inner_type for prim in primitive_types)
             
             # Generate code to check if optional has value
             code_lines.append(f"        // Serialize optional field: {field_name}")
             code_lines.append(f"        if ({field_name}.has_value()) {{")
             
             if is_string:
-                code_lines.append(f"            doc[\"{field_name}\"] = {field_name}.value().c_str();")
+                code_lines.append(f"            out[\"{field_name}\"] = {field_name}.value().c_str();")
             elif is_primitive:
-                code_lines.append(f"            doc[\"{field_name}\"] = {field_name}.value();")
-            elif is_sequential:
-                # Optional of vector/list: SerializeValue returns JSON array string; parse and add as real array
-                code_lines.append(f"            // Serialize array: {field_name}")
-                code_lines.append(f"            StdString {field_name}_json = nayan::serializer::SerializeValue({field_name}.value());")
-                code_lines.append(f"            JsonDocument {field_name}_doc;")
-                code_lines.append(f"            DeserializationError {field_name}_error = deserializeJson({field_name}_doc, {field_name}_json.c_str());")
-                code_lines.append(f"            if ({field_name}_error == DeserializationError::Ok && {field_name}_doc.is<JsonArray>()) {{")
-                code_lines.append(f"                doc[\"{field_name}\"] = {field_name}_doc.as<JsonArray>();")
-                code_lines.append(f"            }} else {{")
-                code_lines.append(f"                doc[\"{field_name}\"] = nullptr;")
-                code_lines.append(f"            }}")
+                code_lines.append(f"            out[\"{field_name}\"] = {field_name}.value();")
             else:
-                # For nested object/enum types in optional, use SerializeValue
-                # SerializeValue handles enums (via template specialization) and complex objects
-                code_lines.append(f"            // Serialize nested object or enum: {field_name}")
-                code_lines.append(f"            // SerializeValue will use template specialization for enums (returns string like \"Off\")")
-                code_lines.append(f"            // or call .Serialize() for complex objects (returns JSON string)")
-                code_lines.append(f"            StdString {field_name}_json = nayan::serializer::SerializeValue({field_name}.value());")
-                code_lines.append(f"            // Try to parse as JSON object (for complex objects)")
-                code_lines.append(f"            JsonDocument {field_name}_doc;")
-                code_lines.append(f"            DeserializationError {field_name}_error = deserializeJson({field_name}_doc, {field_name}_json.c_str());")
-                code_lines.append(f"            if ({field_name}_error == DeserializationError::Ok && {field_name}_doc.is<JsonObject>()) {{")
-                code_lines.append(f"                // Complex object - add parsed JSON object")
-                code_lines.append(f"                doc[\"{field_name}\"] = {field_name}_doc.as<JsonObject>();")
-                code_lines.append(f"            }} else {{")
-                code_lines.append(f"                // Enum (serialized as plain string like \"Off\" or \"On\") - add directly as string value")
-                code_lines.append(f"                // This ensures enums are stored as strings, not integers")
-                code_lines.append(f"                doc[\"{field_name}\"] = {field_name}_json.c_str();")
-                code_lines.append(f"            }}")
+                # Containers, nested objects and enums are written straight into the member slot
+                # (enums via their template specialization as a plain string like "Off",
+                # nested objects via their own SerializeTo)
+                code_lines.append(f"            // Serialize container, nested object or enum in place: {field_name}")
+                code_lines.append(f"            nayan::serializer::SerializationUtility::SerializeInto({field_name}.value(), out[\"{field_name}\"].to<JsonVariant>());")
             
             code_lines.append(f"        }} else {{")
-            code_lines.append(f"            doc[\"{field_name}\"] = nullptr;")
+            code_lines.append(f"            out[\"{field_name}\"] = nullptr;")
             code_lines.append(f"        }}")
     
-    code_lines.append("")
-    code_lines.append("        // Serialize to string")
-    code_lines.append("        StdString output;")
-    code_lines.append("        serializeJson(doc, output);")
-    code_lines.append("")
-    code_lines.append("        return StdString(output.c_str());")
     code_lines.append("    }")
     code_lines.append("")
     
@@ -258,7 +405,13 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
     code_lines.append(f"        Public template<typename DocType>")
     code_lines.append(f"        Static StdString ValidateFields(DocType& doc) {{")
     code_lines.append("        StdString validationErrors;")
+    code_lines.append("        ValidateFields(doc, validationErrors);")
+    code_lines.append("        return validationErrors;")
+    code_lines.append("    }")
     code_lines.append("")
+    code_lines.append("        // Validation into an error sink: StdString collects all messages, ValidationStatus stops at the first field")
+    code_lines.append(f"        Public template<typename DocType, typename ErrorSink>")
+    code_lines.append(f"        Static void ValidateFields(DocType& doc, ErrorSink& validationErrors) {{")
     
     if validation_fields_by_macro:
         # Collect all fields to check for nested object validation
@@ -281,7 +434,9 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
                     inner_type = extract_inner_type_from_optional(field_type)
                     is_primitive = any(prim in inner_type for prim in primitive_types)
                     is_string = 'StdString' in inner_type or 'CStdString' in inner_type or 'string' in inner_type.lower()
-                    if not is_primitive and not is_string:
+                    is_container = is_sequential_container_type(inner_type) or is_associative_container_type(inner_type)
+                    is_bytes = is_base64_bytes_type(inner_type)
+                    if not is_container and not is_primitive and not is_string and not is_bytes:
                         is_nested_object = True
                         nested_type = inner_type
                 
@@ -289,18 +444,12 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
                 if is_nested_object and nested_type:
                     code_lines.append(f"        // First validate nested object: {field_name}")
                     code_lines.append(f"        if (!doc[\"{field_name}\"].isNull()) {{")
-                    code_lines.append(f"            // Extract nested object and convert to JsonDocument for validation")
-                    code_lines.append(f"            JsonObject {field_name}_obj = doc[\"{field_name}\"].template as<JsonObject>();")
-                    code_lines.append(f"            JsonDocument {field_name}_doc;")
-                    code_lines.append(f"            // Copy the JsonObject into JsonDocument")
-                    code_lines.append(f"            {field_name}_doc.set({field_name}_obj);")
+                    code_lines.append(f"            // Read-only view of the nested object inside the parent document (no copy)")
+                    code_lines.append(f"            JsonObjectConst {field_name}_obj = doc[\"{field_name}\"].template as<JsonObjectConst>();")
                     code_lines.append(f"            // Validate nested object's fields")
-                    code_lines.append(f"            StdString {field_name}_nested_errors = {nested_type}::ValidateFields({field_name}_doc);")
-                    code_lines.append(f"            if (!{field_name}_nested_errors.empty()) {{")
-                    code_lines.append(f"                if (!validationErrors.empty()) validationErrors += \",\\n\";")
-                    code_lines.append(f"                validationErrors += \"Validation errors in nested object '{field_name}': \";")
-                    code_lines.append(f"                validationErrors += {field_name}_nested_errors;")
-                    code_lines.append(f"            }}")
+                    code_lines.append(f"            ErrorSink {field_name}_nested_errors;")
+                    code_lines.append(f"            {nested_type}::ValidateFields({field_name}_obj, {field_name}_nested_errors);")
+                    code_lines.append(f"            nayan::validation::ValidationUtility::ReportNestedErrors(validationErrors, \"{field_name}\", {field_name}_nested_errors);")
                     code_lines.append(f"        }}")
                     code_lines.append(f"")
                 
@@ -317,33 +466,81 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
     else:
         code_lines.append("        // No validation macros defined for this class")
     
-    code_lines.append("")
-    code_lines.append("        return validationErrors;")
     code_lines.append("    }")
     code_lines.append("        #pragma GCC diagnostic pop")
     code_lines.append("")
     
-    # Generate static Deserialize() method
-    code_lines.append("    // Deserialization method")
-    code_lines.append(f"    Public Static {class_name} Deserialize(const StdString& input) {{")
-    code_lines.append("        // Create JSON document")
-    code_lines.append("        JsonDocument doc;")
+    # Generate static Deserialize() method - pull parsing through ReadFrom, no document
+    code_lines.append("    // Deserialization method: the generated ReadFrom parses the input in a single pass")
+    code_lines.append(f"    Public Static {class_name} Deserialize(const StdString& input, {context_param}) {{")
+    code_lines.append(f"        return nayan::serializer::SerializationUtility::Deserialize<{class_name}>(input, context);")
+    code_lines.append("    }")
     code_lines.append("")
-    code_lines.append("        // Deserialize JSON string")
-    code_lines.append("        DeserializationError error = deserializeJson(doc, input.c_str());")
+    
+    # Generate static DeserializeMsgPack() method - same pull parser over a MessagePack reader
+    code_lines.append("    // MessagePack deserialization method (fields are validated by ReadFrom)")
+    code_lines.append(f"    Public Static {class_name} DeserializeMsgPack(const StdString& input, {context_param}) {{")
+    code_lines.append(f"        return nayan::serializer::SerializationUtility::DeserializeMsgPack<{class_name}>(input, context);")
+    code_lines.append("    }")
+    code_lines.append("")
+    code_lines.append("    // Non-throwing MessagePack deserialization method")
+    code_lines.append(f"    Public Static nayan::serializer::DeserializeStatus TryDeserializeMsgPack(const StdString& input, {class_name}& out, {context_param}) {{")
+    code_lines.append("        return nayan::serializer::SerializationUtility::TryDeserializeMsgPack(input, out, context);")
+    code_lines.append("    }")
     code_lines.append("")
-    code_lines.append("        if (error) {")
-    code_lines.append("            StdString errorMsg = \"JSON parse error: \";")
-    code_lines.append("            errorMsg += error.c_str();")
-    code_lines.append("            throw std::runtime_error(errorMsg.c_str());")
+    
+    # Generate static FieldSlot() method - minimal perfect hash from a member key to its field,
+    # so FromJson, TryFromJson and ReadFrom walk the input's members once with O(1) dispatch each
+    field_slots = {}
+    if optional_fields:
+        perfect_hash = build_field_perfect_hash([field['name'] for field in optional_fields])
+        slot_names = perfect_hash['slots']
+        field_slots = {name: slot for slot, name in enumerate(slot_names)}
+        slot_count = len(slot_names)
+        code_lines.append("    // Field dispatch: minimal perfect hash over the field names, -1 for keys that are not fields.")
+        code_lines.append("    // expectedSlot (the field declared after the previous key) is compared first, without hashing.")
+        code_lines.append("    Public Static int FieldSlot(const char* key, size_t length, int expectedSlot = -1) {")
+        code_lines.append(f"        static constexpr int32_t displacements[{slot_count}] = {{{', '.join(str(d) for d in perfect_hash['displacements'])}}};")
+        quoted_names = ', '.join('"' + name + '"' for name in slot_names)
+        code_lines.append(f"        static constexpr const char* names[{slot_count}] = {{{quoted_names}}};")
+        code_lines.append(f"        static constexpr size_t lengths[{slot_count}] = {{{', '.join(str(len(name)) for name in slot_names)}}};")
+        code_lines.append("        if (expectedSlot >= 0 && lengths[expectedSlot] == length && std::memcmp(names[expectedSlot], key, length) == 0) {")
+        code_lines.append("            nayan::serializer::FieldMatchCounter::RecordOrderedHit();")
+        code_lines.append("            return expectedSlot;")
+        code_lines.append("        }")
+        code_lines.append("        nayan::serializer::FieldMatchCounter::RecordHashLookup();")
+        code_lines.append("        int32_t displacement = displacements[nayan::serializer::SerializationUtility::FieldNameHash(0, key, length) % " + str(slot_count) + "];")
+        code_lines.append("        uint32_t slot = displacement < 0")
+        code_lines.append("            ? static_cast<uint32_t>(-displacement - 1)")
+        code_lines.append(f"            : nayan::serializer::SerializationUtility::FieldNameHash(static_cast<uint32_t>(displacement), key, length) % {slot_count};")
+        code_lines.append("        if (lengths[slot] != length || std::memcmp(names[slot], key, length) != 0) {")
+        code_lines.append("            return -1;")
+        code_lines.append("        }")
+        code_lines.append("        return static_cast<int>(slot);")
+        code_lines.append("    }")
+        code_lines.append("")
+    
+    # Slot of the field declared after each field (-1 after the last): producers of this library
+    # write keys in declaration order, so this is the key expected next
+    next_slots = {}
+    for position, field in enumerate(optional_fields):
+        following = optional_fields[position + 1]['name'] if position + 1 < len(optional_fields) else None
+        next_slots[field['name']] = field_slots[following] if following else -1
+    first_slot = field_slots[optional_fields[0]['name']] if optional_fields else -1
+    
+    # Generate static FromJson() method - reads fields from an already parsed JSON value
+    code_lines.append("    // Deserialization from a parsed JSON value (used for nested objects and container elements)")
+    code_lines.append(f"    Public Static {class_name} FromJson(JsonVariantConst json) {{")
+    code_lines.append("        if (!json.is<JsonObjectConst>()) {")
+    code_lines.append(f"            NAYAN_SERIALIZER_THROW(std::invalid_argument(\"Type mismatch: {class_name} expects a JSON object\"));")
     code_lines.append("        }")
     code_lines.append("")
     
     # Validate fields using the separate validation function (always call, even if empty)
     code_lines.append("        // Validate all fields with validation macros")
-    code_lines.append("        StdString validationErrors = ValidateFields(doc);")
+    code_lines.append("        StdString validationErrors = ValidateFields(json);")
     code_lines.append("        if (!validationErrors.empty()) {")
-    code_lines.append("            throw std::runtime_error(validationErrors.c_str());")
+    code_lines.append("            NAYAN_SERIALIZER_THROW(std::runtime_error(validationErrors.c_str()));")
     code_lines.append("        }")
     code_lines.append("")
     
@@ -352,118 +549,287 @@ def generate_serialization_methods(class_name: str, fields: List[Dict[str, str]]
     code_lines.append(f"        {class_name} obj;")
     code_lines.append("")
     
-    # Only deserialize optional fields - skip non-optional fields
-    code_lines.append("        // Assign values from JSON if present (only optional fields)")
     # Primitive types that can be deserialized directly
     primitive_types = ['int', 'Int', 'CInt', 'long', 'Long', 'CLong', 'float', 'Float', 'CFloat', 
                       'double', 'Double', 'CDouble', 'bool', 'Bool', 'CBool', 'char', 'Char', 'CChar',
                       'unsigned', 'UInt', 'CUInt', 'short', 'Short', 'CShort']
     
-    # Filter to only optional fields
-    optional_fields = [field for field in fields if is_optional_type(field['type'].strip())]
-    
-    # Create set of validated field names for quick lookup
-    validated_field_names = set()
-    for fields_list in validation_fields_by_macro.values():
-        for field in fields_list:
-            validated_field_names.add(field['name'])
+    def append_field_assignment(indent: str, field_name: str, inner_type: str, source: str) -> None:
+        # Check inner type characteristics (containers first: their element types would match below)
+        is_container = is_sequential_container_type(inner_type) or is_associative_container_type(inner_type)
+        is_string = not is_container and ('StdString' in inner_type or 'CStdString' in inner_type or 'string' in inner_type.lower())
+        is_primitive = not is_container and any(prim in inner_type for prim in primitive_types)
+        
+        if is_string or is_primitive:
+            # Same type checks as TryFromJson and ReadFrom (TypeMismatch, OutOfRange), but thrown
+            code_lines.append(f"{indent}status = nayan::serializer::SerializationUtility::TryDeserializeFrom({source}, obj.{field_name});")
+            code_lines.append(f"{indent}if (!status) {{")
+            code_lines.append(f"{indent}    nayan::serializer::SerializationUtility::throw_status(\"JSON value error: \", status.InField(\"{field_name}\"));")
+            code_lines.append(f"{indent}}}")
+        else:
+            # Containers, nested objects (via their FromJson) and enums are read straight from the tree
+            code_lines.append(f"{indent}// Deserialize container, nested object or enum in place: {field_name}")
+            code_lines.append(f"{indent}obj.{field_name} = nayan::serializer::SerializationUtility::DeserializeFrom<{inner_type}>({source});")
     
     if not optional_fields:
         code_lines.append("        // No optional fields to deserialize")
     else:
+        # Walk the members once; null values leave the optional unset (default state)
+        code_lines.append("        // Assign values from the members that are present (only optional fields)")
+        reads_scalars = False
+        for field in optional_fields:
+            inner_type = extract_inner_type_from_optional(field['type'].strip())
+            if not (is_sequential_container_type(inner_type) or is_associative_container_type(inner_type)):
+                reads_scalars = reads_scalars or 'string' in inner_type.lower() or any(prim in inner_type for prim in primitive_types)
+        if reads_scalars:
+            code_lines.append("        nayan::serializer::DeserializeStatus status;")
+        code_lines.append(f"        int expectedSlot = {first_slot};")
+        code_lines.append("        for (JsonPairConst member : json.as<JsonObjectConst>()) {")
+        code_lines.append("            JsonString key = member.key();")
+        code_lines.append("            JsonVariantConst value = member.value();")
+        code_lines.append("            switch (FieldSlot(key.c_str(), key.size(), expectedSlot)) {")
         for field in optional_fields:
-            field_type = field['type'].strip()
             field_name = field['name']
-            is_validated = field_name in validated_field_names
-            
-            # Extract inner type
-            inner_type = extract_inner_type_from_optional(field_type)
-            
-            # Check inner type characteristics
-            is_primitive = any(prim in inner_type for prim in primitive_types)
-            is_string = 'StdString' in inner_type or 'CStdString' in inner_type or 'string' in inner_type.lower()
-            is_sequential = is_sequential_container_type(inner_type)
-            
-            # For validated fields, directly assign (already validated above)
-            # For optional fields, check if key exists and is not null
-            if is_validated:
-                # Find which validation macros apply to this field
-                validation_macros = []
-                for macro_name, fields_list in validation_fields_by_macro.items():
-                    if any(f['name'] == field_name for f in fields_list):
-                        validation_macros.append(macro_name)
-                validation_desc = "+".join(validation_macros) if validation_macros else "validated"
-                code_lines.append(f"        // Deserialize {validation_desc} field: {field_name} (already validated)")
-                # Direct assignment for NotNull fields (no if check needed)
-                if is_string:
-                    code_lines.append(f"        obj.{field_name} = StdString(doc[\"{field_name}\"].as<const char*>());")
-                elif is_primitive:
-                    # Handle different primitive types
-                    if 'bool' in inner_type.lower() or 'Bool' in inner_type:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<bool>();")
-                    elif 'int' in inner_type.lower() or 'Int' in inner_type:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<int>();")
-                    elif 'float' in inner_type.lower() or 'Float' in inner_type:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<float>();")
-                    elif 'double' in inner_type.lower() or 'Double' in inner_type:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<double>();")
-                    elif 'char' in inner_type.lower() or 'Char' in inner_type:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<char>();")
-                    else:
-                        code_lines.append(f"        obj.{field_name} = doc[\"{field_name}\"].as<{inner_type}>();")
-                elif is_sequential:
-                    code_lines.append(f"        // Deserialize array: {field_name}")
-                    code_lines.append(f"        JsonArray {field_name}_arr = doc[\"{field_name}\"].as<JsonArray>();")
-                    code_lines.append(f"        StdString {field_name}_json;")
-                    code_lines.append(f"        serializeJson({field_name}_arr, {field_name}_json);")
-                    code_lines.append(f"        obj.{field_name} = nayan::serializer::DeserializeValue<{inner_type}>({field_name}_json);")
-                else:
-                    # For nested object types in optional (including enums)
-                    code_lines.append(f"        // Deserialize nested object or enum: {field_name}")
-                    code_lines.append(f"        JsonObject {field_name}_obj = doc[\"{field_name}\"].as<JsonObject>();")
-                    code_lines.append(f"        StdString {field_name}_json;")
-                    code_lines.append(f"        serializeJson({field_name}_obj, {field_name}_json);")
-                    code_lines.append(f"        obj.{field_name} = nayan::serializer::DeserializeValue<{inner_type}>({field_name}_json);")
-            else:
-                code_lines.append(f"        // Deserialize optional field: {field_name}")
-                code_lines.append(f"        if (!doc[\"{field_name}\"].isNull()) {{")
-                
-                if is_string:
-                    code_lines.append(f"            obj.{field_name} = StdString(doc[\"{field_name}\"].as<const char*>());")
-                elif is_primitive:
-                    # Handle different primitive types
-                    if 'bool' in inner_type.lower() or 'Bool' in inner_type:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<bool>();")
-                    elif 'int' in inner_type.lower() or 'Int' in inner_type:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<int>();")
-                    elif 'float' in inner_type.lower() or 'Float' in inner_type:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<float>();")
-                    elif 'double' in inner_type.lower() or 'Double' in inner_type:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<double>();")
-                    elif 'char' in inner_type.lower() or 'Char' in inner_type:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<char>();")
-                    else:
-                        code_lines.append(f"            obj.{field_name} = doc[\"{field_name}\"].as<{inner_type}>();")
-                elif is_sequential:
-                    code_lines.append(f"            // Deserialize array: {field_name}")
-                    code_lines.append(f"            JsonArray {field_name}_arr = doc[\"{field_name}\"].as<JsonArray>();")
-                    code_lines.append(f"            StdString {field_name}_json;")
-                    code_lines.append(f"            serializeJson({field_name}_arr, {field_name}_json);")
-                    code_lines.append(f"            obj.{field_name} = nayan::serializer::DeserializeValue<{inner_type}>({field_name}_json);")
-                else:
-                    # For nested object types in optional (including enums)
-                    code_lines.append(f"            // Deserialize nested object or enum: {field_name}")
-                    code_lines.append(f"            JsonObject {field_name}_obj = doc[\"{field_name}\"].as<JsonObject>();")
-                    code_lines.append(f"            StdString {field_name}_json;")
-                    code_lines.append(f"            serializeJson({field_name}_obj, {field_name}_json);")
-                    code_lines.append(f"            obj.{field_name} = nayan::serializer::DeserializeValue<{inner_type}>({field_name}_json);")
-                
-                code_lines.append(f"        }}")
-                # Note: If key doesn't exist or is null, optional remains unset (default state)
+            inner_type = extract_inner_type_from_optional(field['type'].strip())
+            code_lines.append(f"                case {field_slots[field_name]}: // {field_name}")
+            code_lines.append(f"                    expectedSlot = {next_slots[field_name]};")
+            code_lines.append("                    if (!value.isNull()) {")
+            append_field_assignment("                        ", field_name, inner_type, "value")
+            code_lines.append("                    }")
+            code_lines.append("                    break;")
+        code_lines.append("                default:")
+        code_lines.append("                    // Not a field of this class")
+        code_lines.append("                    break;")
+        code_lines.append("            }")
+        code_lines.append("        }")
     
     code_lines.append("")
     code_lines.append("        return obj;")
     
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate static TryDeserialize() method - non-throwing variant of Deserialize
+    code_lines.append("    // Non-throwing deserialization method: parse errors carry the byte offset, field errors the field name")
+    code_lines.append(f"    Public Static nayan::serializer::DeserializeStatus TryDeserialize(const StdString& input, {class_name}& out, {context_param}) {{")
+    code_lines.append("        return nayan::serializer::SerializationUtility::TryDeserialize(input, out, context);")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate static TryFromJson() method - non-throwing variant of FromJson
+    code_lines.append("    // Non-throwing deserialization from a parsed JSON value: reports the first failing field")
+    code_lines.append(f"    Public Static nayan::serializer::DeserializeStatus TryFromJson(JsonVariantConst json, {class_name}& out) {{")
+    code_lines.append("        if (!json.is<JsonObjectConst>()) {")
+    code_lines.append("            return nayan::serializer::DeserializeStatus::Failure(nayan::serializer::DeserializeError::TypeMismatch);")
+    code_lines.append("        }")
+    code_lines.append("")
+    code_lines.append("        // Validate all fields with validation macros (stops at the first failing field)")
+    code_lines.append("        nayan::validation::ValidationStatus validationStatus;")
+    code_lines.append("        ValidateFields(json, validationStatus);")
+    code_lines.append("        if (!validationStatus.empty()) {")
+    code_lines.append("            return nayan::serializer::DeserializeStatus::Failure(nayan::serializer::DeserializeError::ValidationFailed, validationStatus.field);")
+    code_lines.append("        }")
+    code_lines.append("")
+    code_lines.append(f"        {class_name} obj;")
+    if optional_fields:
+        reads_scalars = False
+        for field in optional_fields:
+            inner_type = extract_inner_type_from_optional(field['type'].strip())
+            if not (is_sequential_container_type(inner_type) or is_associative_container_type(inner_type)):
+                reads_scalars = reads_scalars or 'string' in inner_type.lower() or any(prim in inner_type for prim in primitive_types)
+        if reads_scalars:
+            code_lines.append("        nayan::serializer::DeserializeStatus status;")
+        code_lines.append(f"        int expectedSlot = {first_slot};")
+        code_lines.append("        for (JsonPairConst member : json.as<JsonObjectConst>()) {")
+        code_lines.append("            JsonString key = member.key();")
+        code_lines.append("            switch (FieldSlot(key.c_str(), key.size(), expectedSlot)) {")
+        for field in optional_fields:
+            field_name = field['name']
+            code_lines.append(f"                case {field_slots[field_name]}: // {field_name} (null leaves it empty)")
+            code_lines.append(f"                    expectedSlot = {next_slots[field_name]};")
+            code_lines.append(f"                    status = nayan::serializer::SerializationUtility::TryDeserializeFrom(member.value(), obj.{field_name});")
+            code_lines.append("                    if (!status) {")
+            code_lines.append(f"                        return status.InField(\"{field_name}\");")
+            code_lines.append("                    }")
+            code_lines.append("                    break;")
+        code_lines.append("                default:")
+        code_lines.append("                    // Not a field of this class")
+        code_lines.append("                    break;")
+        code_lines.append("            }")
+        code_lines.append("        }")
+    else:
+        code_lines.append("        // No optional fields to deserialize")
+    code_lines.append("")
+    code_lines.append("        out = std::move(obj);")
+    code_lines.append("        return nayan::serializer::DeserializeStatus::Success();")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Binary field ids: //@FieldId(n) when given, otherwise the 1-based declaration position.
+    # Ids go on the wire, so a clash (also between an explicit id and a position) is an error here
+    # rather than a duplicate case label in DecodeBinary
+    field_ids = {}
+    fields_by_id = {}
+    for position, field in enumerate(fields, 1):
+        field_id = field.get('field_id', position)
+        source = f"//@FieldId({field_id})" if 'field_id' in field else f"declaration position {position}"
+        if field_id < 1 or field_id > 0xFFFFFFFF:
+            raise ValueError(f"{class_name}::{field['name']}: field id {field_id} ({source}) must be between 1 and 4294967295")
+        if field_id in fields_by_id:
+            other_name, other_source = fields_by_id[field_id]
+            raise ValueError(f"{class_name}::{field['name']}: field id {field_id} ({source}) is already used by "
+                             f"{class_name}::{other_name} ({other_source})")
+        fields_by_id[field_id] = (field['name'], source)
+        field_ids[field['name']] = field_id
+    
+    # ReadFrom and DecodeBinary validate the filled object instead of a document: the built-in macros
+    # have object-level counterparts in ValidationUtility; any other validation function (or a
+    # validated non-optional field) needs the document, so the object's JSON form is validated instead
+    value_validators = {
+        'ValidateNotNull': 'ValidateNotNullValue',
+        'ValidateNotBlank': 'ValidateNotBlankValue',
+        'ValidateNotEmpty': 'ValidateNotEmptyValue',
+    }
+    optional_field_names = set(field['name'] for field in optional_fields)
+    value_checks = []
+    document_validation = False
+    for macro_name, fields_list in validation_fields_by_macro.items():
+        for field in fields_list:
+            validator = field['function_name'].split('::')[-1].strip()
+            if validator in value_validators and field['name'] in optional_field_names:
+                value_checks.append((field['name'], value_validators[validator]))
+            else:
+                document_validation = True
+    
+    def append_value_validation() -> None:
+        if not value_checks and not document_validation:
+            return
+        code_lines.append("")
+        code_lines.append("        // Validate the filled object (same rules as ValidateFields)")
+        code_lines.append("        nayan::validation::ValidationStatus validationStatus;")
+        if document_validation:
+            code_lines.append("        // Custom validation functions read a document: check the object's JSON form")
+            code_lines.append("        nayan::serializer::DocumentLease lease = nayan::serializer::ScratchDocumentPool::Local().Acquire();")
+            code_lines.append("        JsonDocument& doc = lease.Document();")
+            code_lines.append("        obj.SerializeTo(doc.to<JsonObject>());")
+            code_lines.append("        JsonVariantConst json = doc.as<JsonVariantConst>();")
+            code_lines.append("        ValidateFields(json, validationStatus);")
+        else:
+            for field_name, validator in value_checks:
+                code_lines.append(f"        nayan::validation::ValidationUtility::{validator}(obj.{field_name}, \"{field_name}\", validationStatus);")
+        code_lines.append("        if (!validationStatus.empty()) {")
+        code_lines.append("            return nayan::serializer::DeserializeStatus::Failure(nayan::serializer::DeserializeError::ValidationFailed, validationStatus.field);")
+        code_lines.append("        }")
+    
+    # Generate static ReadFrom() method - pull parsing through any Reader backend, no document
+    code_lines.append("    // Format-agnostic deserialization: reads the fields through any Reader backend, unknown keys are skipped")
+    code_lines.append("    Public template<typename Reader>")
+    code_lines.append(f"    Static nayan::serializer::DeserializeStatus ReadFrom(Reader& reader, {class_name}& out) {{")
+    code_lines.append("        nayan::serializer::DeserializeError error = reader.BeginObject();")
+    code_lines.append("        if (error != nayan::serializer::DeserializeError::Ok) {")
+    code_lines.append("            return nayan::serializer::DeserializeStatus::Failure(error, nullptr, reader.Position());")
+    code_lines.append("        }")
+    code_lines.append("")
+    code_lines.append(f"        {class_name} obj;")
+    if optional_fields:
+        code_lines.append(f"        int expectedSlot = {first_slot};")
+    code_lines.append("        while (true) {")
+    code_lines.append("            bool found = false;")
+    code_lines.append("            const char* key = nullptr;")
+    code_lines.append("            size_t keyLength = 0;")
+    code_lines.append("            error = reader.NextMember(found, key, keyLength);")
+    code_lines.append("            if (error != nayan::serializer::DeserializeError::Ok) {")
+    code_lines.append("                return nayan::serializer::DeserializeStatus::Failure(error, nullptr, reader.Position());")
+    code_lines.append("            }")
+    code_lines.append("            if (!found) {")
+    code_lines.append("                break;")
+    code_lines.append("            }")
+    code_lines.append("")
+    if optional_fields:
+        code_lines.append("            nayan::serializer::DeserializeStatus status;")
+        code_lines.append("            switch (FieldSlot(key, keyLength, expectedSlot)) {")
+        for field in optional_fields:
+            field_name = field['name']
+            code_lines.append(f"                case {field_slots[field_name]}: // {field_name}")
+            code_lines.append(f"                    expectedSlot = {next_slots[field_name]};")
+            code_lines.append(f"                    status = nayan::serializer::SerializationUtility::Read(reader, obj.{field_name});")
+            code_lines.append("                    if (!status) {")
+            code_lines.append(f"                        return status.InField(\"{field_name}\");")
+            code_lines.append("                    }")
+            code_lines.append("                    continue;")
+        code_lines.append("                default:")
+        code_lines.append("                    break;")
+        code_lines.append("            }")
+    code_lines.append("            // Unknown member")
+    code_lines.append("            error = reader.Skip();")
+    code_lines.append("            if (error != nayan::serializer::DeserializeError::Ok) {")
+    code_lines.append("                return nayan::serializer::DeserializeStatus::Failure(error, nullptr, reader.Position());")
+    code_lines.append("            }")
+    code_lines.append("        }")
+    append_value_validation()
+    code_lines.append("")
+    code_lines.append("        out = std::move(obj);")
+    code_lines.append("        return nayan::serializer::DeserializeStatus::Success();")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate EncodeBinary() methods - compact tagged binary format, no JSON document involved
+    code_lines.append("    // Compact binary serialization: tagged fields, absent values omitted")
+    code_lines.append("    Public void EncodeBinary(nayan::serializer::BinaryWriter& writer) const {")
+    if optional_fields:
+        for field in optional_fields:
+            field_name = field['name']
+            code_lines.append(f"        if ({field_name}.has_value()) {{")
+            code_lines.append(f"            nayan::serializer::BinaryCodec::EncodeField(writer, {field_ids[field_name]}, {field_name}.value());")
+            code_lines.append("        }")
+    else:
+        code_lines.append("        // No optional fields to encode")
+        code_lines.append("        (void)writer;")
+    code_lines.append("    }")
+    code_lines.append("")
+    code_lines.append("    Public StdString EncodeBinary() const {")
+    code_lines.append("        return nayan::serializer::BinaryCodec::Encode(*this);")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate static DecodeBinary() methods - unknown field ids are skipped
+    code_lines.append("    // Compact binary deserialization: unknown field ids are skipped, later duplicates win")
+    code_lines.append(f"    Public Static nayan::serializer::DeserializeStatus DecodeBinary(nayan::serializer::BinaryReader& reader, {class_name}& out) {{")
+    code_lines.append(f"        {class_name} obj;")
+    code_lines.append("        while (!reader.AtEnd()) {")
+    code_lines.append("            uint32_t fieldId = 0;")
+    code_lines.append("            nayan::serializer::WireType wireType = nayan::serializer::WireType::Varint;")
+    code_lines.append("            nayan::serializer::DeserializeError error = reader.ReadTag(fieldId, wireType);")
+    code_lines.append("            if (error != nayan::serializer::DeserializeError::Ok) {")
+    code_lines.append("                return nayan::serializer::DeserializeStatus::Failure(error, nullptr, reader.Position());")
+    code_lines.append("            }")
+    code_lines.append("")
+    code_lines.append("            nayan::serializer::DeserializeStatus status;")
+    code_lines.append("            switch (fieldId) {")
+    for field in optional_fields:
+        field_name = field['name']
+        code_lines.append(f"                case {field_ids[field_name]}:")
+        code_lines.append(f"                    status = nayan::serializer::BinaryCodec::DecodeField(reader, wireType, obj.{field_name});")
+        code_lines.append("                    if (!status) {")
+        code_lines.append(f"                        return status.InField(\"{field_name}\");")
+        code_lines.append("                    }")
+        code_lines.append("                    break;")
+    code_lines.append("                default:")
+    code_lines.append("                    error = reader.Skip(wireType);")
+    code_lines.append("                    if (error != nayan::serializer::DeserializeError::Ok) {")
+    code_lines.append("                        return nayan::serializer::DeserializeStatus::Failure(error, nullptr, reader.Position());")
+    code_lines.append("                    }")
+    code_lines.append("                    break;")
+    code_lines.append("            }")
+    code_lines.append("        }")
+    append_value_validation()
+    code_lines.append("")
+    code_lines.append("        out = std::move(obj);")
+    code_lines.append("        return nayan::serializer::DeserializeStatus::Success();")
+    code_lines.append("    }")
+    code_lines.append("")
+    code_lines.append(f"    Public Static nayan::serializer::DeserializeStatus DecodeBinary(const StdString& input, {class_name}& out) {{")
+    code_lines.append("        return nayan::serializer::BinaryCodec::Decode(input, out);")
     code_lines.append("    }")
     
     return "\n".join(code_lines)
@@ -787,6 +1153,7 @@ __all__ = [
     'is_optional_type',
     'extract_inner_type_from_optional',
     'is_sequential_container_type',
+    'is_associative_container_type',
     'generate_serialization_methods',
     'mark_dto_annotation_processed',
     'comment_dto_macro',  # Keep for backward compatibility
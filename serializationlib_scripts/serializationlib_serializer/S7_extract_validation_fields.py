@@ -138,7 +138,7 @@ def extract_validation_fields(file_path: str, class_name: str, validation_macros
         stripped = line.strip()
         
         # Skip comments (but not the annotation itself which is in a comment)
-        if stripped.startswith('/*'):
+        if stripped.startswith('/*') and not re.search(validation_pattern, stripped):
             i += 1
             continue
         # Skip other single-line comments that aren't annotations
@@ -201,6 +201,42 @@ def generate_enum_serialization_code(enum_name: str, enum_values: List[str]) ->
     code_lines.append("    }")
     code_lines.append("")
     
+    # Generate non-throwing TryParseEnum specialization (unknown names are reported, not defaulted);
+    # it comes first because the Deserialize specialization below uses it
+    code_lines.append("    /**")
+    code_lines.append(f"     * Parse {enum_name} enum from its name without allocating")
+    code_lines.append("     */")
+    code_lines.append(f"    template<>")
+    code_lines.append(f"    inline bool SerializationUtility::TryParseEnum<{enum_name}>(const char* text, size_t length, {enum_name}& out) {{")
+    for value in enum_values:
+        code_lines.append(f"        if (text_equals_ignore_case(text, length, \"{value}\")) {{")
+        code_lines.append(f"            out = {enum_name}::{value};")
+        code_lines.append("            return true;")
+        code_lines.append("        }")
+    if not enum_values:
+        code_lines.append("        (void)text;")
+        code_lines.append("        (void)length;")
+        code_lines.append("        (void)out;")
+    code_lines.append("        return false;")
+    code_lines.append("    }")
+    code_lines.append("")
+    
+    # Generate DefaultEnumValue specialization: the first enumerator stands for unknown names
+    # unless NAYAN_SERIALIZER_STRICT_ENUMS is set (see SerializationUtility::ParseEnumName)
+    code_lines.append("    /**")
+    code_lines.append(f"     * Value of {enum_name} used for unknown names")
+    code_lines.append("     */")
+    code_lines.append(f"    template<>")
+    code_lines.append(f"    inline bool SerializationUtility::DefaultEnumValue<{enum_name}>({enum_name}& out) {{")
+    if enum_values:
+        code_lines.append(f"        out = {enum_name}::{enum_values[0]};")
+        code_lines.append("        return true;")
+    else:
+        code_lines.append("        (void)out;")
+        code_lines.append("        return false;")
+    code_lines.append("    }")
+    code_lines.append("")
+    
     # Generate Deserialize template specialization
     code_lines.append("    /**")
     code_lines.append(f"     * Deserialize JSON string to {enum_name} enum")
@@ -214,27 +250,19 @@ def generate_enum_serialization_code(enum_name: str, enum_values: List[str]) ->
     code_lines.append("        }")
     code_lines.append("        ")
     code_lines.append("        // Try to parse as JSON first (handles quoted strings)")
-    code_lines.append("        JsonDocument doc;")
+    code_lines.append("        DocumentLease lease = SerializationContext::Default().AcquireDocument();")
+    code_lines.append("        JsonDocument& doc = lease.Document();")
     code_lines.append("        DeserializationError error = deserializeJson(doc, input.c_str());")
     code_lines.append("        if (error == DeserializationError::Ok && doc.is<const char*>()) {")
     code_lines.append("            cleaned = StdString(doc.as<const char*>());")
     code_lines.append("        }")
     code_lines.append("        ")
-    code_lines.append("        // Convert string to enum")
-    code_lines.append("        // Case-insensitive comparison")
-    code_lines.append("        StdString lower = cleaned;")
-    code_lines.append("        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);")
-    code_lines.append("        ")
-    
-    for value in enum_values:
-        value_lower = value.lower()
-        code_lines.append(f"        if (lower == \"{value_lower}\" || cleaned == \"{value}\") {{")
-        code_lines.append(f"            return {enum_name}::{value};")
-        code_lines.append("        }")
-    
-    code_lines.append("        ")
-    code_lines.append("        // Default or unknown value")
-    code_lines.append(f"        return {enum_name}::{enum_values[0] if enum_values else 'UNKNOWN'};")
+    code_lines.append("        // Convert string to enum (case-insensitive; unknown names as on every other path)")
+    code_lines.append(f"        {enum_name} value{{}};")
+    code_lines.append("        if (!ParseEnumName(cleaned.data(), cleaned.length(), value)) {")
+    code_lines.append(f"            NAYAN_SERIALIZER_THROW(std::invalid_argument(\"Unknown {enum_name} value: \" + SerializationUtility::input_excerpt(cleaned)));")
+    code_lines.append("        }")
+    code_lines.append("        return value;")
     code_lines.append("    }")
     code_lines.append("")
     
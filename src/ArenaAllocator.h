@@ -0,0 +1,173 @@
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include <ArduinoJson.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Bump-pointer ArduinoJson allocator over a fixed buffer.
+ *
+ * allocate() moves a pointer forward, deallocate() is a no-op and Reset() releases
+ * everything at once, so all document storage of one request becomes a single reset.
+ * When the buffer is exhausted allocate() returns nullptr and ArduinoJson reports NoMemory.
+ *
+ * Usage:
+ *   StaticArenaAllocator<8192> arena;
+ *   SerializationContext context(&arena);
+ *   Foo foo = SerializationUtility::Deserialize<Foo>(input, context);
+ *   ...
+ *   arena.Reset(); // once every document created from the context is destroyed
+ *
+ * Not thread-safe: use one arena per thread or per request.
+ */
+class ArenaAllocator : public ArduinoJson::Allocator {
+public:
+    /**
+     * @param buffer Storage for allocations (not owned)
+     * @param capacity Size of the storage in bytes
+     */
+    ArenaAllocator(void* buffer, size_t capacity)
+        : begin_(static_cast<unsigned char*>(buffer)), end_(begin_ + capacity), current_(begin_), last_(nullptr) {
+        // Start on an aligned address
+        current_ = align(current_);
+        if (current_ > end_) {
+            current_ = end_;
+        }
+        start_ = current_;
+    }
+
+    void* allocate(size_t size) override {
+        unsigned char* block = current_;
+        if (!fits(block, size)) {
+            return nullptr;
+        }
+        write_size(block, size);
+        last_ = block;
+        current_ = next_block(block, size);
+        return block + HeaderSize;
+    }
+
+    void deallocate(void* pointer) override {
+        // Memory is released by Reset()
+        (void)pointer;
+    }
+
+    void* reallocate(void* pointer, size_t newSize) override {
+        if (pointer == nullptr) {
+            return allocate(newSize);
+        }
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HeaderSize;
+        size_t oldSize = read_size(block);
+
+        // The most recent block can grow or shrink in place
+        if (block == last_) {
+            if (!fits(block, newSize)) {
+                return nullptr;
+            }
+            write_size(block, newSize);
+            current_ = next_block(block, newSize);
+            return pointer;
+        }
+
+        // Shrinking an older block keeps its storage
+        if (newSize <= oldSize) {
+            write_size(block, newSize);
+            return pointer;
+        }
+
+        void* moved = allocate(newSize);
+        if (moved != nullptr) {
+            std::memcpy(moved, pointer, oldSize);
+        }
+        return moved;
+    }
+
+    /**
+     * Release every allocation at once.
+     * Documents created from this allocator must be destroyed (or cleared) before the reset.
+     */
+    void Reset() {
+        current_ = start_;
+        last_ = nullptr;
+    }
+
+    /**
+     * Number of bytes currently in use, including block headers and alignment padding.
+     */
+    size_t Used() const {
+        return static_cast<size_t>(current_ - start_);
+    }
+
+    /**
+     * Usable size of the arena in bytes.
+     */
+    size_t Capacity() const {
+        return static_cast<size_t>(end_ - start_);
+    }
+
+private:
+    static constexpr size_t Alignment = alignof(std::max_align_t);
+    // Each block stores its size so reallocate() can copy it; the header keeps payloads aligned
+    static constexpr size_t HeaderSize = (sizeof(size_t) + Alignment - 1) / Alignment * Alignment;
+
+    static unsigned char* align(unsigned char* pointer) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        uintptr_t aligned = (address + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+        return pointer + (aligned - address);
+    }
+
+    // Start of the block after one of the given size; the padding never reaches past end_
+    unsigned char* next_block(unsigned char* block, size_t size) const {
+        unsigned char* next = align(block + HeaderSize + size);
+        return next > end_ ? end_ : next;
+    }
+
+    bool fits(const unsigned char* block, size_t size) const {
+        if (block > end_) {
+            return false;
+        }
+        size_t available = static_cast<size_t>(end_ - block);
+        return available >= HeaderSize && size <= available - HeaderSize;
+    }
+
+    static void write_size(unsigned char* block, size_t size) {
+        std::memcpy(block, &size, sizeof(size));
+    }
+
+    static size_t read_size(const unsigned char* block) {
+        size_t size = 0;
+        std::memcpy(&size, block, sizeof(size));
+        return size;
+    }
+
+    unsigned char* begin_;
+    unsigned char* end_;
+    unsigned char* current_;
+    unsigned char* last_;
+    unsigned char* start_;
+};
+
+/**
+ * ArenaAllocator with inline storage of StorageSize bytes.
+ */
+template<size_t StorageSize>
+class StaticArenaAllocator : public ArenaAllocator {
+public:
+    StaticArenaAllocator() : ArenaAllocator(storage_, StorageSize) {}
+
+    StaticArenaAllocator(const StaticArenaAllocator&) = delete;
+    StaticArenaAllocator& operator=(const StaticArenaAllocator&) = delete;
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[StorageSize];
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // ARENA_ALLOCATOR_H
@@ -0,0 +1,264 @@
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <StandardDefines.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "SimdSupport.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Standard base64 (RFC 4648 alphabet, '=' padding).
+ *
+ * Encoding turns 24 bytes into 32 characters per step and decoding does the reverse with AVX2
+ * when the CPU has it (the kernels need byte shuffles, which SSE2 alone does not provide);
+ * the tail and other CPUs use a table-driven loop.
+ */
+class Base64 {
+public:
+    static constexpr size_t EncodedLength(size_t length) {
+        return (length + 2) / 3 * 4;
+    }
+
+    /**
+     * Upper bound of the decoded size of `length` characters (exact when there is no padding).
+     */
+    static constexpr size_t DecodedCapacity(size_t length) {
+        return length / 4 * 3;
+    }
+
+    /**
+     * Write the EncodedLength(length) characters for `length` bytes into `out`.
+     */
+    static void Encode(const uint8_t* data, size_t length, char* out) {
+        size_t consumed = 0;
+        size_t produced = 0;
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (length >= 28 && has_avx2()) {
+            encode_avx2(data, length, out, consumed, produced);
+        }
+#endif
+        encode_scalar(data + consumed, length - consumed, out + produced);
+    }
+
+    /**
+     * Decode `length` characters into `out`, which must have room for DecodedCapacity(length) bytes.
+     * Returns false for a length that is not a multiple of 4, a character outside the alphabet
+     * or misplaced padding; `written` receives the number of bytes decoded.
+     */
+    static bool Decode(const char* text, size_t length, uint8_t* out, size_t& written) {
+        written = 0;
+        if (length % 4 != 0) {
+            return false;
+        }
+        size_t consumed = 0;
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (length >= 44 && has_avx2()) {
+            decode_avx2(text, length, out, consumed, written);
+        }
+#endif
+        return decode_scalar(text + consumed, length - consumed, out, written);
+    }
+
+    /**
+     * Name of the kernels used on this machine: "avx2" or "scalar".
+     */
+    static const char* Backend() {
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (has_avx2()) {
+            return "avx2";
+        }
+#endif
+        return "scalar";
+    }
+
+private:
+    static constexpr const char* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr uint8_t Invalid = 0xFF;
+
+    static void encode_scalar(const uint8_t* data, size_t length, char* out) {
+        size_t i = 0;
+        for (; i + 3 <= length; i += 3) {
+            uint32_t triple = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+            *out++ = Alphabet[(triple >> 18) & 0x3F];
+            *out++ = Alphabet[(triple >> 12) & 0x3F];
+            *out++ = Alphabet[(triple >> 6) & 0x3F];
+            *out++ = Alphabet[triple & 0x3F];
+        }
+        if (i < length) {
+            uint32_t triple = static_cast<uint32_t>(data[i]) << 16;
+            if (i + 1 < length) {
+                triple |= static_cast<uint32_t>(data[i + 1]) << 8;
+            }
+            *out++ = Alphabet[(triple >> 18) & 0x3F];
+            *out++ = Alphabet[(triple >> 12) & 0x3F];
+            *out++ = i + 1 < length ? Alphabet[(triple >> 6) & 0x3F] : '=';
+            *out++ = '=';
+        }
+    }
+
+    static bool decode_scalar(const char* text, size_t length, uint8_t* out, size_t& written) {
+        const uint8_t* table = decode_table();
+        for (size_t i = 0; i < length; i += 4) {
+            bool isLast = i + 4 == length;
+            // Padding is only allowed as the last one or two characters
+            size_t padding = 0;
+            if (isLast && text[i + 3] == '=') {
+                padding = text[i + 2] == '=' ? 2 : 1;
+            }
+            uint32_t quad = 0;
+            for (size_t j = 0; j < 4 - padding; ++j) {
+                uint8_t value = table[static_cast<unsigned char>(text[i + j])];
+                if (value == Invalid) {
+                    return false;
+                }
+                quad |= static_cast<uint32_t>(value) << (18 - 6 * j);
+            }
+            out[written++] = static_cast<uint8_t>(quad >> 16);
+            if (padding < 2) {
+                out[written++] = static_cast<uint8_t>(quad >> 8);
+            }
+            if (padding < 1) {
+                out[written++] = static_cast<uint8_t>(quad);
+            }
+        }
+        return true;
+    }
+
+    static const uint8_t* decode_table() {
+        static const std::array<uint8_t, 256> table = build_decode_table();
+        return table.data();
+    }
+
+    static std::array<uint8_t, 256> build_decode_table() {
+        std::array<uint8_t, 256> table{};
+        table.fill(Invalid);
+        for (uint8_t i = 0; i < 64; ++i) {
+            table[static_cast<unsigned char>(Alphabet[i])] = i;
+        }
+        return table;
+    }
+
+#if NAYAN_SERIALIZER_SIMD_AVX2
+    // CPU check happens once per process
+    static bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // Each step reads 28 bytes (two overlapping 16-byte lanes, 12 bytes used from each) and
+    // writes 32 characters; 6-bit indices are mapped to ASCII with one shuffle of offsets
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static void encode_avx2(const uint8_t* data, size_t length, char* out, size_t& consumed, size_t& produced) {
+        const __m256i spread = _mm256_setr_epi8(
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const __m256i offsets = _mm256_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        while (length - consumed >= 28) {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + consumed));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + consumed + 12));
+            __m256i input = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), spread);
+
+            // Move the four 6-bit groups of every 3 bytes into their own bytes
+            __m256i first = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+            __m256i second = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+            __m256i indices = _mm256_or_si256(first, second);
+
+            // 0-25 -> 13, 26-51 -> 0, 52-61 -> 1-10, 62 -> 11, 63 -> 12
+            __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+            range = _mm256_or_si256(range, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+            __m256i characters = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + produced), characters);
+            consumed += 24;
+            produced += 32;
+        }
+    }
+
+    // Each step validates and decodes 32 characters into 24 bytes. A block with a character
+    // outside the alphabet (padding included) is left to the scalar loop, which reports it.
+    // The 32-byte store needs 32 bytes of room, hence the 44 characters kept ahead.
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static void decode_avx2(const char* text, size_t length, uint8_t* out, size_t& consumed, size_t& written) {
+        const __m256i lowNibbleClasses = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i highNibbleClasses = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i shifts = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i pack = _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+        while (length - consumed >= 44) {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + consumed));
+            __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibbleMask);
+            __m256i lowNibbles = _mm256_and_si256(input, nibbleMask);
+            __m256i lowClasses = _mm256_shuffle_epi8(lowNibbleClasses, lowNibbles);
+            __m256i highClasses = _mm256_shuffle_epi8(highNibbleClasses, highNibbles);
+            if (!_mm256_testz_si256(lowClasses, highClasses)) {
+                return;
+            }
+            __m256i isSlash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/'));
+            __m256i values = _mm256_add_epi8(input, _mm256_shuffle_epi8(shifts, _mm256_add_epi8(isSlash, highNibbles)));
+
+            // Join 4 x 6 bits into 3 bytes per 32-bit group, then drop the empty fourth bytes
+            __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+            __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(groups, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), bytes);
+            consumed += 32;
+            written += 24;
+        }
+    }
+#endif
+};
+
+/**
+ * Opt-in trait for byte buffers written as base64 strings instead of arrays of numbers.
+ * True for Base64Bytes and Base64Array; specialize it for other byte containers with
+ * data()/size() (and resize() unless the size is fixed):
+ *
+ *   template<> struct nayan::serializer::is_base64_bytes<Firmware> : std::true_type {};
+ */
+template<typename T>
+struct is_base64_bytes : std::false_type {};
+
+/**
+ * StdVector<UInt8> serialized as a base64 string (e.g. firmware images, thumbnails).
+ */
+class Base64Bytes : public StdVector<UInt8> {
+public:
+    using StdVector<UInt8>::StdVector;
+};
+
+/**
+ * StdArray<UInt8, N> serialized as a base64 string; the decoded length must be exactly N.
+ */
+template<std::size_t N>
+class Base64Array : public StdArray<UInt8, N> {};
+
+template<>
+struct is_base64_bytes<Base64Bytes> : std::true_type {};
+
+template<std::size_t N>
+struct is_base64_bytes<Base64Array<N>> : std::true_type {};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // BASE64_H
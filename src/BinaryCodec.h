@@ -0,0 +1,588 @@
+#ifndef BINARY_CODEC_H
+#define BINARY_CODEC_H
+
+#include <StandardDefines.h>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "SerializationErrors.h"
+#include "SerializationUtility.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Wire types of the compact binary format (same numbering as protobuf).
+ */
+enum class WireType : uint8_t {
+    Varint = 0,          // bool, integers (signed ones zigzag encoded), enums
+    Fixed64 = 1,         // double
+    LengthDelimited = 2, // strings, containers, nested objects
+    Fixed32 = 5          // float
+};
+
+/**
+ * Appends compact binary encoding to a string.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(StdString& output) : output_(output) {}
+
+    void WriteVarint(uint64_t value) {
+        char buffer[MaxVarintLength];
+        output_.append(buffer, encode_varint(value, buffer));
+    }
+
+    void WriteSignedVarint(int64_t value) {
+        // Zigzag: small negative numbers stay short
+        WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void WriteTag(uint32_t fieldId, WireType type) {
+        WriteVarint((static_cast<uint64_t>(fieldId) << 3) | static_cast<uint64_t>(type));
+    }
+
+    void WriteFixed32(uint32_t value) {
+        char bytes[4];
+        for (size_t i = 0; i < 4; ++i) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        output_.append(bytes, 4);
+    }
+
+    void WriteFixed64(uint64_t value) {
+        char bytes[8];
+        for (size_t i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        output_.append(bytes, 8);
+    }
+
+    /**
+     * Write a length-prefixed byte string.
+     */
+    void WriteBytes(const char* data, size_t length) {
+        WriteVarint(length);
+        output_.append(data, length);
+    }
+
+    /**
+     * Start a length-delimited payload whose size is not known yet.
+     * Reserves one byte for the length; EndLengthDelimited widens it if needed.
+     *
+     * Widening moves the payload once (payloads of 128 bytes or more), so a large object nested
+     * N levels deep is moved N times. A wider reserved prefix would avoid the move but make
+     * every small payload larger, and the exact size would need a second pass over the value.
+     *
+     * @return Marker to pass to EndLengthDelimited
+     */
+    size_t BeginLengthDelimited() {
+        output_.push_back('\0');
+        return output_.size();
+    }
+
+    void EndLengthDelimited(size_t marker) {
+        char buffer[MaxVarintLength];
+        size_t length = encode_varint(output_.size() - marker, buffer);
+        if (length > 1) {
+            output_.insert(marker, length - 1, '\0');
+        }
+        std::memcpy(&output_[marker - 1], buffer, length);
+    }
+
+    StdString& Output() {
+        return output_;
+    }
+
+private:
+    static constexpr size_t MaxVarintLength = 10;
+
+    static size_t encode_varint(uint64_t value, char* buffer) {
+        size_t length = 0;
+        while (value >= 0x80) {
+            buffer[length++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buffer[length++] = static_cast<char>(value);
+        return length;
+    }
+
+    StdString& output_;
+};
+
+/**
+ * Reads compact binary encoding from a byte range. Never reads past the end.
+ */
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t length) : data_(data), length_(length), position_(0) {}
+
+    bool AtEnd() const {
+        return position_ >= length_;
+    }
+
+    size_t Position() const {
+        return position_;
+    }
+
+    DeserializeError ReadVarint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (position_ >= length_) {
+                return DeserializeError::IncompleteInput;
+            }
+            uint8_t byte = static_cast<uint8_t>(data_[position_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return DeserializeError::Ok;
+            }
+        }
+        // More than 10 bytes: not a valid varint
+        return DeserializeError::InvalidInput;
+    }
+
+    DeserializeError ReadSignedVarint(int64_t& value) {
+        uint64_t raw = 0;
+        DeserializeError error = ReadVarint(raw);
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return error;
+    }
+
+    DeserializeError ReadTag(uint32_t& fieldId, WireType& type) {
+        uint64_t tag = 0;
+        DeserializeError error = ReadVarint(tag);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if ((tag >> 3) > std::numeric_limits<uint32_t>::max()) {
+            return DeserializeError::InvalidInput;
+        }
+        fieldId = static_cast<uint32_t>(tag >> 3);
+        type = static_cast<WireType>(tag & 0x7);
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadFixed32(uint32_t& value) {
+        if (length_ - position_ < 4) {
+            return DeserializeError::IncompleteInput;
+        }
+        value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(data_[position_ + i])) << (8 * i);
+        }
+        position_ += 4;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadFixed64(uint64_t& value) {
+        if (length_ - position_ < 8) {
+            return DeserializeError::IncompleteInput;
+        }
+        value = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[position_ + i])) << (8 * i);
+        }
+        position_ += 8;
+        return DeserializeError::Ok;
+    }
+
+    /**
+     * Read a length-prefixed payload without copying it.
+     */
+    DeserializeError ReadLengthDelimited(const char*& data, size_t& length) {
+        uint64_t size = 0;
+        DeserializeError error = ReadVarint(size);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if (size > length_ - position_) {
+            return DeserializeError::IncompleteInput;
+        }
+        data = data_ + position_;
+        length = static_cast<size_t>(size);
+        position_ += length;
+        return DeserializeError::Ok;
+    }
+
+    /**
+     * Skip a value of the given wire type (used for unknown field ids).
+     */
+    DeserializeError Skip(WireType type) {
+        switch (type) {
+            case WireType::Varint: {
+                uint64_t ignored = 0;
+                return ReadVarint(ignored);
+            }
+            case WireType::Fixed64: {
+                uint64_t ignored = 0;
+                return ReadFixed64(ignored);
+            }
+            case WireType::Fixed32: {
+                uint32_t ignored = 0;
+                return ReadFixed32(ignored);
+            }
+            case WireType::LengthDelimited: {
+                const char* ignored = nullptr;
+                size_t length = 0;
+                return ReadLengthDelimited(ignored, length);
+            }
+        }
+        return DeserializeError::InvalidInput;
+    }
+
+private:
+    const char* data_;
+    size_t length_;
+    size_t position_;
+};
+
+/**
+ * Schema-driven compact binary format (protobuf-lite style).
+ *
+ * Serializable objects are encoded by the generated EncodeBinary/DecodeBinary as a sequence of
+ * (field id, wire type) tags followed by values; fields without a value are omitted and unknown
+ * ids are skipped, so fields can be added or removed without breaking older readers.
+ * Values are encoded as:
+ *   - bool, integers, enums: varint (signed integers zigzag encoded)
+ *   - float / double: little-endian fixed32 / fixed64
+ *   - strings: length-prefixed bytes
+ *   - containers: length-prefixed payload holding the element count and the elements
+ *     (maps: alternating keys and values)
+ *   - nested objects: length-prefixed payload holding their fields
+ *
+ * No JSON document is built on either side.
+ */
+class BinaryCodec {
+public:
+    /**
+     * Encode a value (serializable objects use their generated EncodeBinary).
+     */
+    template<typename T>
+    static StdString Encode(const T& value) {
+        StdString output;
+        BinaryWriter writer(output);
+        if constexpr (has_encode_binary<T>::value) {
+            value.EncodeBinary(writer);
+        } else {
+            EncodeValue(writer, value);
+        }
+        return output;
+    }
+
+    /**
+     * Decode a value produced by Encode.
+     */
+    template<typename T>
+    static DeserializeStatus Decode(const char* data, size_t length, T& out) {
+        BinaryReader reader(data, length);
+        if constexpr (has_decode_binary<T>::value) {
+            return T::DecodeBinary(reader, out);
+        } else {
+            T value{};
+            DeserializeStatus status = DecodeValue(reader, value);
+            if (status) {
+                out = std::move(value);
+            }
+            return status;
+        }
+    }
+
+    template<typename T>
+    static DeserializeStatus Decode(const StdString& input, T& out) {
+        return Decode(input.data(), input.size(), out);
+    }
+
+    /**
+     * Wire type used for values of type T.
+     */
+    template<typename T>
+    static constexpr WireType WireTypeOf() {
+        if constexpr (std::is_same_v<T, float>) {
+            return WireType::Fixed32;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return WireType::Fixed64;
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            return WireType::Varint;
+        } else {
+            return WireType::LengthDelimited;
+        }
+    }
+
+    /**
+     * Write one tagged field (used by the generated EncodeBinary).
+     */
+    template<typename T>
+    static void EncodeField(BinaryWriter& writer, uint32_t fieldId, const T& value) {
+        writer.WriteTag(fieldId, WireTypeOf<T>());
+        EncodeValue(writer, value);
+    }
+
+    /**
+     * Read the value of a tagged field into an optional member (used by the generated DecodeBinary).
+     */
+    template<typename T>
+    static DeserializeStatus DecodeField(BinaryReader& reader, WireType type, std::optional<T>& field) {
+        if (type != WireTypeOf<T>()) {
+            return DeserializeStatus::Failure(DeserializeError::TypeMismatch, nullptr, reader.Position());
+        }
+        T value{};
+        DeserializeStatus status = DecodeValue(reader, value);
+        if (status) {
+            field = std::move(value);
+        }
+        return status;
+    }
+
+    /**
+     * Encode a value without a tag.
+     */
+    template<typename T>
+    static void EncodeValue(BinaryWriter& writer, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            writer.WriteVarint(value ? 1 : 0);
+        } else if constexpr (std::is_enum_v<T>) {
+            EncodeValue(writer, static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            writer.WriteSignedVarint(static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            writer.WriteVarint(static_cast<uint64_t>(value));
+        } else if constexpr (std::is_same_v<T, float>) {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writer.WriteFixed32(bits);
+        } else if constexpr (std::is_same_v<T, double>) {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writer.WriteFixed64(bits);
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, std::string>) {
+            writer.WriteBytes(value.data(), value.size());
+        } else if constexpr (SerializationUtility::is_base64_bytes_v<T>) {
+            // Base64 is only a text encoding: the binary format stores the bytes as they are
+            writer.WriteBytes(reinterpret_cast<const char*>(value.data()), value.size());
+        } else if constexpr (SerializationUtility::is_optional_type_v<T>) {
+            // Nested optionals (e.g. container elements): empty payload means no value
+            size_t marker = writer.BeginLengthDelimited();
+            if (value.has_value()) {
+                EncodeValue(writer, value.value());
+            }
+            writer.EndLengthDelimited(marker);
+        } else if constexpr (SerializationUtility::is_sequential_container_v<T>) {
+            size_t marker = writer.BeginLengthDelimited();
+            writer.WriteVarint(static_cast<uint64_t>(std::distance(value.begin(), value.end())));
+            for (const auto& element : value) {
+                EncodeValue(writer, element);
+            }
+            writer.EndLengthDelimited(marker);
+        } else if constexpr (SerializationUtility::is_associative_container_v<T>) {
+            size_t marker = writer.BeginLengthDelimited();
+            writer.WriteVarint(static_cast<uint64_t>(value.size()));
+            for (const auto& pair : value) {
+                EncodeValue(writer, pair.first);
+                EncodeValue(writer, pair.second);
+            }
+            writer.EndLengthDelimited(marker);
+        } else {
+            static_assert(has_encode_binary<T>::value, "EncodeBinary not found. Re-run S3_inject_serialization.py for this class.");
+            size_t marker = writer.BeginLengthDelimited();
+            value.EncodeBinary(writer);
+            writer.EndLengthDelimited(marker);
+        }
+    }
+
+    /**
+     * Decode a value without a tag. `out` may be partially written on failure.
+     */
+    template<typename T>
+    static DeserializeStatus DecodeValue(BinaryReader& reader, T& out) {
+        if constexpr (std::is_same_v<T, bool>) {
+            uint64_t raw = 0;
+            DeserializeError error = reader.ReadVarint(raw);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            if (raw > 1) {
+                return fail(DeserializeError::OutOfRange, reader);
+            }
+            out = raw == 1;
+            return DeserializeStatus::Success();
+        } else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> raw{};
+            DeserializeStatus status = DecodeValue(reader, raw);
+            if (status) {
+                out = static_cast<T>(raw);
+            }
+            return status;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            int64_t raw = 0;
+            DeserializeError error = reader.ReadSignedVarint(raw);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            if (raw < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+                raw > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                return fail(DeserializeError::OutOfRange, reader);
+            }
+            out = static_cast<T>(raw);
+            return DeserializeStatus::Success();
+        } else if constexpr (std::is_integral_v<T>) {
+            uint64_t raw = 0;
+            DeserializeError error = reader.ReadVarint(raw);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            if (raw > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                return fail(DeserializeError::OutOfRange, reader);
+            }
+            out = static_cast<T>(raw);
+            return DeserializeStatus::Success();
+        } else if constexpr (std::is_same_v<T, float>) {
+            uint32_t bits = 0;
+            DeserializeError error = reader.ReadFixed32(bits);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            std::memcpy(&out, &bits, sizeof(bits));
+            return DeserializeStatus::Success();
+        } else if constexpr (std::is_same_v<T, double>) {
+            uint64_t bits = 0;
+            DeserializeError error = reader.ReadFixed64(bits);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            std::memcpy(&out, &bits, sizeof(bits));
+            return DeserializeStatus::Success();
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, std::string>) {
+            const char* data = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadLengthDelimited(data, length);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            out.assign(data, length);
+            return DeserializeStatus::Success();
+        } else if constexpr (SerializationUtility::is_base64_bytes_v<T>) {
+            const char* data = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadLengthDelimited(data, length);
+            if (error == DeserializeError::Ok) {
+                error = SerializationUtility::assign_bytes(reinterpret_cast<const uint8_t*>(data), length, out);
+            }
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            return DeserializeStatus::Success();
+        } else {
+            // Length-delimited payload decoded with its own reader, so it cannot overrun
+            const char* data = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadLengthDelimited(data, length);
+            if (error != DeserializeError::Ok) {
+                return fail(error, reader);
+            }
+            BinaryReader payload(data, length);
+            size_t base = reader.Position() - length;
+            DeserializeStatus status = decode_payload(payload, out);
+            if (!status && status.offset != 0) {
+                status.offset += base;
+            }
+            return status;
+        }
+    }
+
+    /**
+     * Type trait to check if a type provides EncodeBinary(BinaryWriter&) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_encode_binary : std::false_type {};
+
+    template<typename T>
+    struct has_encode_binary<T, std::void_t<decltype(std::declval<const T&>().EncodeBinary(std::declval<BinaryWriter&>()))>>
+        : std::true_type {};
+
+    /**
+     * Type trait to check if a type provides static DecodeBinary(BinaryReader&, T&) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_decode_binary : std::false_type {};
+
+    template<typename T>
+    struct has_decode_binary<T, std::void_t<decltype(T::DecodeBinary(std::declval<BinaryReader&>(), std::declval<T&>()))>>
+        : std::true_type {};
+
+private:
+    static DeserializeStatus fail(DeserializeError error, const BinaryReader& reader) {
+        return DeserializeStatus::Failure(error, nullptr, reader.Position());
+    }
+
+    template<typename T>
+    static DeserializeStatus decode_payload(BinaryReader& payload, T& out) {
+        if constexpr (SerializationUtility::is_optional_type_v<T>) {
+            if (payload.AtEnd()) {
+                out.reset();
+                return DeserializeStatus::Success();
+            }
+            typename T::value_type value{};
+            DeserializeStatus status = DecodeValue(payload, value);
+            if (status) {
+                out = std::move(value);
+            }
+            return status;
+        } else if constexpr (SerializationUtility::is_sequential_container_v<T>) {
+            using ValueType = typename T::value_type;
+            uint64_t count = 0;
+            DeserializeError error = payload.ReadVarint(count);
+            if (error != DeserializeError::Ok) {
+                return fail(error, payload);
+            }
+            if constexpr (SerializationUtility::is_std_array_type<T>::value) {
+                if (count != std::tuple_size_v<T>) {
+                    return fail(DeserializeError::SizeMismatch, payload);
+                }
+            }
+            T container{};
+            for (uint64_t index = 0; index < count; ++index) {
+                ValueType value{};
+                DeserializeStatus status = DecodeValue(payload, value);
+                if (!status) {
+                    return status;
+                }
+                SerializationUtility::add_element<T, ValueType>(container, std::move(value), static_cast<size_t>(index));
+            }
+            out = std::move(container);
+            return DeserializeStatus::Success();
+        } else if constexpr (SerializationUtility::is_associative_container_v<T>) {
+            uint64_t count = 0;
+            DeserializeError error = payload.ReadVarint(count);
+            if (error != DeserializeError::Ok) {
+                return fail(error, payload);
+            }
+            T map;
+            for (uint64_t index = 0; index < count; ++index) {
+                typename T::key_type key{};
+                typename T::mapped_type value{};
+                DeserializeStatus status = DecodeValue(payload, key);
+                if (status) {
+                    status = DecodeValue(payload, value);
+                }
+                if (!status) {
+                    return status;
+                }
+                map[std::move(key)] = std::move(value);
+            }
+            out = std::move(map);
+            return DeserializeStatus::Success();
+        } else {
+            static_assert(has_decode_binary<T>::value, "DecodeBinary not found. Re-run S3_inject_serialization.py for this class.");
+            return T::DecodeBinary(payload, out);
+        }
+    }
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // BINARY_CODEC_H
@@ -0,0 +1,76 @@
+#ifndef FIELD_MATCH_STATS_H
+#define FIELD_MATCH_STATS_H
+
+#include <cstddef>
+
+// Count how member keys are matched by the generated FieldSlot (off by default: no cost on the hot path)
+#ifndef NAYAN_SERIALIZER_FIELD_MATCH_STATS
+#define NAYAN_SERIALIZER_FIELD_MATCH_STATS 0
+#endif
+
+// Single-threaded targets without TLS support can define this as empty
+#ifndef NAYAN_SERIALIZER_THREAD_LOCAL
+#define NAYAN_SERIALIZER_THREAD_LOCAL thread_local
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Per-thread counters of the generated key dispatch.
+ * Keys written by this library arrive in declaration order, so orderedHits should dominate;
+ * a growing share of hashLookups means producers reorder keys or send unknown ones.
+ */
+struct FieldMatchStats {
+    size_t orderedHits = 0;   // Key equal to the field declared after the previous key
+    size_t hashLookups = 0;   // Key dispatched through the perfect hash (out of order or unknown)
+
+    /**
+     * Share of keys matched without hashing (0 when nothing was counted).
+     */
+    double HitRate() const {
+        size_t total = orderedHits + hashLookups;
+        return total == 0 ? 0.0 : static_cast<double>(orderedHits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * Collects FieldMatchStats when NAYAN_SERIALIZER_FIELD_MATCH_STATS is set to 1.
+ * Otherwise the Record methods compile to nothing and Stats() stays zero.
+ */
+class FieldMatchCounter {
+public:
+    static void RecordOrderedHit() {
+#if NAYAN_SERIALIZER_FIELD_MATCH_STATS
+        ++local().orderedHits;
+#endif
+    }
+
+    static void RecordHashLookup() {
+#if NAYAN_SERIALIZER_FIELD_MATCH_STATS
+        ++local().hashLookups;
+#endif
+    }
+
+    /**
+     * Counters for the calling thread since the last ResetStats().
+     */
+    static FieldMatchStats Stats() {
+        return local();
+    }
+
+    static void ResetStats() {
+        local() = FieldMatchStats();
+    }
+
+private:
+    static FieldMatchStats& local() {
+        static NAYAN_SERIALIZER_THREAD_LOCAL FieldMatchStats stats;
+        return stats;
+    }
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // FIELD_MATCH_STATS_H
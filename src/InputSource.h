@@ -0,0 +1,210 @@
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include <StandardDefines.h>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bytes requested from the source per read; the buffer grows beyond it only for larger values
+#ifndef NAYAN_SERIALIZER_SOURCE_CHUNK_SIZE
+#define NAYAN_SERIALIZER_SOURCE_CHUNK_SIZE 4096
+#endif
+
+// FdSource (and FdSink) are available where POSIX read/write exist
+#ifndef NAYAN_SERIALIZER_POSIX_IO
+#if defined(__unix__) || defined(__APPLE__)
+#define NAYAN_SERIALIZER_POSIX_IO 1
+#else
+#define NAYAN_SERIALIZER_POSIX_IO 0
+#endif
+#endif
+
+#if NAYAN_SERIALIZER_POSIX_IO
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Source concept
+ *
+ * SerializationUtility::ForEachElement pulls JSON text from a Source through a SourceBuffer, so
+ * an input of any size is never held in memory at once. A Source provides:
+ *
+ *   size_t Read(char* buffer, size_t capacity);   // bytes stored in buffer, 0 at the end of the input
+ *   bool Failed() const;                           // true when the end came from a read error
+ *
+ * Sources: IstreamSource (std::istream), FdSource (POSIX file descriptor) and MemorySource (a character range).
+ */
+
+/**
+ * Type trait to check if a type implements the Source concept.
+ */
+template<typename T, typename = void>
+struct is_input_source : std::false_type {};
+
+template<typename T>
+struct is_input_source<T, std::void_t<decltype(std::declval<T&>().Read(std::declval<char*>(), std::declval<size_t>())),
+                                      decltype(static_cast<bool>(std::declval<const T&>().Failed()))>>
+    : std::true_type {};
+
+/**
+ * Source over a std::istream (file, std::cin, ...).
+ */
+class IstreamSource {
+public:
+    explicit IstreamSource(std::istream& stream) : stream_(stream) {}
+
+    size_t Read(char* buffer, size_t capacity) {
+        stream_.read(buffer, static_cast<std::streamsize>(capacity));
+        return static_cast<size_t>(stream_.gcount());
+    }
+
+    bool Failed() const {
+        return stream_.bad();
+    }
+
+private:
+    std::istream& stream_;
+};
+
+#if NAYAN_SERIALIZER_POSIX_IO
+/**
+ * Source over a POSIX file descriptor (file, pipe, socket); EINTR is retried.
+ * The descriptor is not closed.
+ */
+class FdSource {
+public:
+    explicit FdSource(int fd) : fd_(fd), failed_(false) {}
+
+    size_t Read(char* buffer, size_t capacity) {
+        while (true) {
+            ssize_t count = ::read(fd_, buffer, capacity);
+            if (count >= 0) {
+                return static_cast<size_t>(count);
+            }
+            if (errno != EINTR) {
+                failed_ = true;
+                return 0;
+            }
+        }
+    }
+
+    bool Failed() const {
+        return failed_;
+    }
+
+private:
+    int fd_;
+    bool failed_;
+};
+#endif
+
+/**
+ * Source over characters already in memory (e.g. a memory-mapped file).
+ */
+class MemorySource {
+public:
+    MemorySource(const char* data, size_t length) : data_(data), length_(length), position_(0) {}
+
+    size_t Read(char* buffer, size_t capacity) {
+        size_t count = capacity < length_ - position_ ? capacity : length_ - position_;
+        std::memcpy(buffer, data_ + position_, count);
+        position_ += count;
+        return count;
+    }
+
+    bool Failed() const {
+        return false;
+    }
+
+private:
+    const char* data_;
+    size_t length_;
+    size_t position_;
+};
+
+/**
+ * Sliding window over a Source: holds the bytes that are not consumed yet and reads more in
+ * chunks of NAYAN_SERIALIZER_SOURCE_CHUNK_SIZE. It only grows while a single value is larger
+ * than the window, so its size is bounded by the largest value plus one chunk.
+ * Data() moves when Fill is called; keep offsets relative to it, not pointers.
+ */
+template<typename Source>
+class SourceBuffer {
+public:
+    explicit SourceBuffer(Source& source, size_t chunkSize = NAYAN_SERIALIZER_SOURCE_CHUNK_SIZE)
+        : source_(source), chunkSize_(chunkSize > 0 ? chunkSize : 1), begin_(0), end_(0), position_(0), ended_(false) {}
+
+    const char* Data() const {
+        return buffer_.data() + begin_;
+    }
+
+    size_t Size() const {
+        return end_ - begin_;
+    }
+
+    /**
+     * Offset of Data()[0] from the start of the input.
+     */
+    size_t Position() const {
+        return position_;
+    }
+
+    /**
+     * Drop the first `count` buffered bytes.
+     */
+    void Consume(size_t count) {
+        begin_ += count;
+        position_ += count;
+    }
+
+    /**
+     * Read more input after the buffered bytes.
+     * Returns false at the end of the input or after a read error (see Failed).
+     */
+    bool Fill() {
+        if (ended_) {
+            return false;
+        }
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+        }
+        if (buffer_.size() - end_ < chunkSize_) {
+            buffer_.resize(end_ + chunkSize_);
+        }
+        size_t count = source_.Read(buffer_.data() + end_, buffer_.size() - end_);
+        if (count == 0) {
+            ended_ = true;
+            return false;
+        }
+        end_ += count;
+        return true;
+    }
+
+    bool Failed() const {
+        return source_.Failed();
+    }
+
+private:
+    Source& source_;
+    size_t chunkSize_;
+    StdVector<char> buffer_;
+    size_t begin_;
+    size_t end_;
+    size_t position_;
+    bool ended_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // INPUT_SOURCE_H
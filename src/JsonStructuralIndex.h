@@ -0,0 +1,207 @@
+#ifndef JSON_STRUCTURAL_INDEX_H
+#define JSON_STRUCTURAL_INDEX_H
+
+#include <StandardDefines.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "SimdSupport.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * String index of a JSON text: the positions of every unescaped quote (both the opening and the
+ * closing one), in input order.
+ *
+ * The input is classified 64 bytes at a time (AVX2 or SSE2 when the CPU has them, a portable
+ * loop otherwise) and escaped quotes are masked out with bit arithmetic, so building the index
+ * touches each byte once. A JsonReader constructed with an index uses it to find the end of
+ * strings without scanning their bytes again. Brackets, colons and commas are not recorded:
+ * the reader validates every value it skips, so it has to visit them anyway.
+ */
+class JsonStructuralIndex {
+public:
+    /**
+     * Index `length` bytes of JSON text.
+     * Returns false (and leaves the index empty) when the input ends inside a string or is too
+     * large for 32-bit positions; the reader then works without an index and reports the error.
+     */
+    bool Build(const char* data, size_t length) {
+        positions_.clear();
+        if (static_cast<uint64_t>(length) > UINT32_MAX) {
+            return false;
+        }
+        // Quotes are typically a few percent of a document
+        positions_.reserve(length / 16 + 16);
+
+        ClassifyFunction classify = classifier();
+        uint64_t previousEscaped = 0;
+        uint64_t previousInString = 0;
+        char padded[64];
+        for (size_t base = 0; base < length; base += 64) {
+            const char* block = data + base;
+            if (length - base < 64) {
+                // Spaces are neutral for every mask
+                std::memset(padded, ' ', sizeof(padded));
+                std::memcpy(padded, block, length - base);
+                block = padded;
+            }
+
+            uint64_t quotes = 0;
+            uint64_t backslashes = 0;
+            classify(block, quotes, backslashes);
+
+            quotes &= ~escaped_characters(backslashes, previousEscaped);
+            // Bits from an opening quote up to (not including) its closing quote
+            uint64_t inString = prefix_xor(quotes) ^ previousInString;
+            previousInString = static_cast<uint64_t>(0) - (inString >> 63);
+
+            append_positions(base, quotes);
+        }
+        if (previousInString != 0) {
+            positions_.clear();
+            return false;
+        }
+        return true;
+    }
+
+    const uint32_t* Positions() const {
+        return positions_.data();
+    }
+
+    size_t Count() const {
+        return positions_.size();
+    }
+
+    /**
+     * Name of the kernel Build uses on this machine: "avx2", "sse2" or "scalar".
+     */
+    static const char* Backend() {
+        ClassifyFunction classify = classifier();
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (classify == &classify_avx2) {
+            return "avx2";
+        }
+#endif
+#if NAYAN_SERIALIZER_SIMD_X86
+        if (classify == &classify_sse2) {
+            return "sse2";
+        }
+#endif
+        (void)classify;
+        return "scalar";
+    }
+
+private:
+    typedef void (*ClassifyFunction)(const char* block, uint64_t& quotes, uint64_t& backslashes);
+
+    // Kernel selection happens once per process
+    static ClassifyFunction classifier() {
+        static const ClassifyFunction selected = select_classifier();
+        return selected;
+    }
+
+    static ClassifyFunction select_classifier() {
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            return &classify_avx2;
+        }
+#endif
+#if NAYAN_SERIALIZER_SIMD_X86
+        return &classify_sse2;
+#else
+        return &classify_scalar;
+#endif
+    }
+
+    static void classify_scalar(const char* block, uint64_t& quotes, uint64_t& backslashes) {
+        for (size_t i = 0; i < 64; ++i) {
+            uint64_t bit = static_cast<uint64_t>(1) << i;
+            switch (block[i]) {
+                case '"': quotes |= bit; break;
+                case '\\': backslashes |= bit; break;
+                default: break;
+            }
+        }
+    }
+
+#if NAYAN_SERIALIZER_SIMD_X86
+    static void classify_sse2(const char* block, uint64_t& quotes, uint64_t& backslashes) {
+        for (size_t i = 0; i < 4; ++i) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+            size_t shift = 16 * i;
+            quotes |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'))))) << shift;
+            backslashes |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))))) << shift;
+        }
+    }
+#endif
+
+#if NAYAN_SERIALIZER_SIMD_AVX2
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static void classify_avx2(const char* block, uint64_t& quotes, uint64_t& backslashes) {
+        for (size_t i = 0; i < 2; ++i) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * i));
+            size_t shift = 32 * i;
+            quotes |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'))))) << shift;
+            backslashes |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))))) << shift;
+        }
+    }
+#endif
+
+    // Characters preceded by an unescaped backslash; backslashes are rare, so they are walked one by one
+    static uint64_t escaped_characters(uint64_t backslashes, uint64_t& previousEscaped) {
+        uint64_t escaped = previousEscaped;
+        backslashes &= ~previousEscaped;
+        previousEscaped = 0;
+        while (backslashes != 0) {
+            uint64_t lowest = backslashes & (~backslashes + 1);
+            if (lowest == (static_cast<uint64_t>(1) << 63)) {
+                // The escaped character starts the next block
+                previousEscaped = 1;
+                break;
+            }
+            escaped |= lowest << 1;
+            backslashes &= ~(lowest | (lowest << 1));
+        }
+        return escaped;
+    }
+
+    // Bit i of the result is the parity of bits 0..i of the input
+    static uint64_t prefix_xor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    void append_positions(size_t base, uint64_t bits) {
+        while (bits != 0) {
+            positions_.push_back(static_cast<uint32_t>(base + count_trailing_zeros(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    static size_t count_trailing_zeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(bits));
+#else
+        size_t count = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    StdVector<uint32_t> positions_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // JSON_STRUCTURAL_INDEX_H
@@ -12,6 +12,13 @@ using std::optional;
 #include <ArduinoJson.h>
 #include <StandardDefines.h>
 #include "SerializationUtility.h"
+#include "ArenaAllocator.h"
+#include "BinaryCodec.h"
+#include "Ndjson.h"
 #include "ValidationIncludes.h"
 
+// Byte buffers written as base64 strings, usable unqualified as DTO field types
+using nayan::serializer::Base64Bytes;
+using nayan::serializer::Base64Array;
+
 #endif // NAYANSERIALIZER_H
@@ -0,0 +1,254 @@
+#ifndef NDJSON_H
+#define NDJSON_H
+
+#include <StandardDefines.h>
+#include <cstring>
+#include <type_traits>
+#include "SerializationUtility.h"
+#include "OutputSink.h"
+#include "InputSource.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Writes newline-delimited JSON (one compact record per line) into a Sink.
+ *
+ * Records are written with SerializationUtility::Write (the generated WriteTo, no document) into
+ * one output buffer that is reused for the whole batch and handed to the sink whenever it holds
+ * NAYAN_SERIALIZER_SINK_BUFFER_SIZE bytes. The sink must outlive the writer; the remaining output
+ * is flushed by Flush() or by the destructor.
+ *
+ *   OstreamSink sink(file);
+ *   NdjsonWriter<LogEntry> writer(sink);
+ *   for (const LogEntry& entry : entries) {
+ *       writer.Write(entry);
+ *   }
+ *   bool ok = writer.Flush();
+ */
+template<typename T>
+class NdjsonWriter {
+public:
+    template<typename Sink>
+    explicit NdjsonWriter(Sink& sink)
+        : sink_(&sink), write_(&write_chunk<Sink>), count_(0), failed_(false) {
+        static_assert(is_output_sink<Sink>::value, "NdjsonWriter needs a Sink (see OutputSink.h)");
+        buffer_.reserve(NAYAN_SERIALIZER_SINK_BUFFER_SIZE);
+    }
+
+    NdjsonWriter(const NdjsonWriter&) = delete;
+    NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+    ~NdjsonWriter() {
+        Flush();
+    }
+
+    /**
+     * Append one record as a line.
+     * Returns false once the sink has failed.
+     */
+    bool Write(const T& record) {
+        // The writer quotes and escapes strings (newlines included) and writes an empty optional
+        // as null, so every record is exactly one non-blank line
+        JsonWriter<StdString> writer(buffer_);
+        SerializationUtility::Write(writer, record);
+        buffer_.push_back('\n');
+        ++count_;
+        if (buffer_.size() >= NAYAN_SERIALIZER_SINK_BUFFER_SIZE) {
+            return Flush();
+        }
+        return !failed_;
+    }
+
+    /**
+     * Pass the buffered lines to the sink.
+     * Returns false if the sink failed at any point.
+     */
+    bool Flush() {
+        if (!buffer_.empty()) {
+            if (!failed_ && !write_(sink_, buffer_.data(), buffer_.size())) {
+                failed_ = true;
+            }
+            buffer_.clear();
+        }
+        return !failed_;
+    }
+
+    /**
+     * Number of records written so far.
+     */
+    size_t Count() const {
+        return count_;
+    }
+
+private:
+    typedef bool (*WriteFunction)(void* sink, const char* data, size_t length);
+
+    template<typename Sink>
+    static bool write_chunk(void* sink, const char* data, size_t length) {
+        return static_cast<Sink*>(sink)->Write(data, length);
+    }
+
+    void* sink_;
+    WriteFunction write_;
+    StdString buffer_;
+    size_t count_;
+    bool failed_;
+};
+
+/**
+ * Reads newline-delimited JSON (one record per line) from a Source.
+ *
+ * The input is read in chunks into one buffer that is reused for the whole batch, so memory
+ * use is bounded by the longest line. Each line is parsed and validated like TryDeserialize;
+ * a line that fails is reported through its status and skipped, and reading continues with
+ * the next line. Blank lines are ignored. The source must outlive the reader.
+ *
+ *   IstreamSource source(file);
+ *   NdjsonReader<LogEntry> reader(source);
+ *   LogEntry entry;
+ *   DeserializeStatus status;
+ *   while (reader.Next(entry, status)) {
+ *       if (!status) {
+ *           report(reader.Line(), status);   // status.offset is the column in that line
+ *           continue;
+ *       }
+ *       process(entry);
+ *   }
+ */
+template<typename T>
+class NdjsonReader {
+public:
+    template<typename Source>
+    explicit NdjsonReader(Source& source, const SerializationContext& context = SerializationContext::Default())
+        : source_(source), input_(source_), context_(context), line_(0), errors_(0), reportedFailure_(false) {
+        static_assert(is_input_source<Source>::value, "NdjsonReader needs a Source (see InputSource.h)");
+    }
+
+    NdjsonReader(const NdjsonReader&) = delete;
+    NdjsonReader& operator=(const NdjsonReader&) = delete;
+
+    /**
+     * Read the next non-blank line.
+     * Returns false at the end of the input. Otherwise `status` tells whether `record` was
+     * filled; on failure `record` is left unchanged (a read error of the source is reported
+     * once as IoError, then the reader ends).
+     */
+    bool Next(T& record, DeserializeStatus& status) {
+        while (true) {
+            size_t length = 0;
+            size_t consumed = 0;
+            if (!find_line(length, consumed)) {
+                if (input_.Failed() && !reportedFailure_) {
+                    reportedFailure_ = true;
+                    ++errors_;
+                    status = DeserializeStatus::Failure(DeserializeError::IoError, nullptr, 0);
+                    return true;
+                }
+                return false;
+            }
+            ++line_;
+
+            const char* text = input_.Data();
+            size_t start = 0;
+            while (start < length && SerializationUtility::is_json_whitespace(text[start])) {
+                ++start;
+            }
+            while (length > start && SerializationUtility::is_json_whitespace(text[length - 1])) {
+                --length;
+            }
+            if (start == length) {
+                input_.Consume(consumed);
+                continue;
+            }
+
+            status = SerializationUtility::read_complete_value(text + start, length - start, record, context_);
+            input_.Consume(consumed);
+            if (!status) {
+                status.offset += start;
+                ++errors_;
+            }
+            return true;
+        }
+    }
+
+    /**
+     * 1-based number of the line returned by the last Next call.
+     */
+    size_t Line() const {
+        return line_;
+    }
+
+    /**
+     * Number of lines that failed so far.
+     */
+    size_t Errors() const {
+        return errors_;
+    }
+
+private:
+    /**
+     * Source behind a pair of function pointers, so the reader type does not depend on it.
+     */
+    class ErasedSource {
+    public:
+        template<typename Source>
+        explicit ErasedSource(Source& source)
+            : source_(&source), read_(&read_chunk<Source>), failed_(&source_failed<Source>) {}
+
+        size_t Read(char* buffer, size_t capacity) {
+            return read_(source_, buffer, capacity);
+        }
+
+        bool Failed() const {
+            return failed_(source_);
+        }
+
+    private:
+        template<typename Source>
+        static size_t read_chunk(void* source, char* buffer, size_t capacity) {
+            return static_cast<Source*>(source)->Read(buffer, capacity);
+        }
+
+        template<typename Source>
+        static bool source_failed(const void* source) {
+            return static_cast<const Source*>(source)->Failed();
+        }
+
+        void* source_;
+        size_t (*read_)(void* source, char* buffer, size_t capacity);
+        bool (*failed_)(const void* source);
+    };
+
+    // Length of the next line (without '\n') and the bytes to consume with it; false at the end
+    bool find_line(size_t& length, size_t& consumed) {
+        size_t searched = 0;
+        while (true) {
+            const void* newline = input_.Size() > searched ? std::memchr(input_.Data() + searched, '\n', input_.Size() - searched) : nullptr;
+            if (newline != nullptr) {
+                length = static_cast<size_t>(static_cast<const char*>(newline) - input_.Data());
+                consumed = length + 1;
+                return true;
+            }
+            searched = input_.Size();
+            if (!input_.Fill()) {
+                // The last line may end without a newline
+                length = input_.Size();
+                consumed = length;
+                return length > 0;
+            }
+        }
+    }
+
+    ErasedSource source_;
+    SourceBuffer<ErasedSource> input_;
+    SerializationContext context_;
+    size_t line_;
+    size_t errors_;
+    bool reportedFailure_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // NDJSON_H
@@ -0,0 +1,264 @@
+#ifndef NUMERIC_CONVERSION_UTILITY_H
+#define NUMERIC_CONVERSION_UTILITY_H
+
+#include <StandardDefines.h>
+#include <charconv>
+#include <system_error>
+#include <type_traits>
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <clocale>
+
+// Floating point to_chars/from_chars are only available in newer standard libraries
+// (libstdc++ 11+, MSVC 19.24+). Older toolchains (e.g. some embedded GCC builds) fall back to
+// snprintf/strtod on a stack buffer, translating the decimal point of the current C locale
+// so the text is still locale-independent.
+#ifndef NAYAN_SERIALIZER_FLOAT_CHARCONV
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define NAYAN_SERIALIZER_FLOAT_CHARCONV 1
+#else
+#define NAYAN_SERIALIZER_FLOAT_CHARCONV 0
+#endif
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Result of a numeric formatting or parsing operation.
+ */
+enum class NumericConversionStatus {
+    Ok,
+    InvalidArgument,  // Input is not a number of the requested type
+    OutOfRange,       // Value does not fit in the requested type
+    BufferTooSmall    // Output buffer cannot hold the formatted value
+};
+
+/**
+ * Locale-independent numeric formatting and parsing.
+ * Built on std::to_chars/std::from_chars with stack buffers: no allocation, no exceptions.
+ *
+ * Floating point values are formatted in the shortest form that parses back to the same value.
+ */
+class NumericConversionUtility {
+public:
+    /**
+     * Buffer size that is large enough for any formatted integer or floating point value.
+     */
+    static constexpr size_t MaxFormattedLength = 32;
+
+    /**
+     * Format a numeric value into a caller-provided buffer (not null-terminated).
+     *
+     * @tparam T Integer or floating point type (bool is not supported)
+     * @param value The value to format
+     * @param buffer Output buffer
+     * @param capacity Size of the output buffer
+     * @param length Receives the number of characters written
+     * @return NumericConversionStatus::Ok on success
+     */
+    template<typename T>
+    static NumericConversionStatus FormatNumber(T value, char* buffer, size_t capacity, size_t& length) {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "FormatNumber requires an integer or floating point type");
+        length = 0;
+        if constexpr (std::is_integral_v<T>) {
+            std::to_chars_result result = std::to_chars(buffer, buffer + capacity, value);
+            if (result.ec != std::errc()) {
+                return NumericConversionStatus::BufferTooSmall;
+            }
+            length = static_cast<size_t>(result.ptr - buffer);
+            return NumericConversionStatus::Ok;
+        } else {
+#if NAYAN_SERIALIZER_FLOAT_CHARCONV
+            // Shortest round-trip representation
+            std::to_chars_result result = std::to_chars(buffer, buffer + capacity, value);
+            if (result.ec != std::errc()) {
+                return NumericConversionStatus::BufferTooSmall;
+            }
+            length = static_cast<size_t>(result.ptr - buffer);
+            return NumericConversionStatus::Ok;
+#else
+            return format_floating_fallback(value, buffer, capacity, length);
+#endif
+        }
+    }
+
+    /**
+     * Parse a numeric value from a character range.
+     * Leading/trailing whitespace and a leading '+' are accepted; any other trailing character is an error,
+     * as is a second sign after the '+' (e.g. "+-5").
+     *
+     * @tparam T Integer or floating point type (bool is not supported)
+     * @param first Start of the input
+     * @param last End of the input
+     * @param out Receives the parsed value (unchanged on failure)
+     * @return NumericConversionStatus::Ok on success
+     */
+    template<typename T>
+    static NumericConversionStatus ParseNumber(const char* first, const char* last, T& out) {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "ParseNumber requires an integer or floating point type");
+        while (first < last && is_space(*first)) {
+            ++first;
+        }
+        while (last > first && is_space(*(last - 1))) {
+            --last;
+        }
+        if (first < last && *first == '+') {
+            ++first;
+            // from_chars accepts a '-' of its own, which would make "+-5" parse as -5
+            if (first < last && (*first == '-' || *first == '+')) {
+                return NumericConversionStatus::InvalidArgument;
+            }
+        }
+        if (first == last) {
+            return NumericConversionStatus::InvalidArgument;
+        }
+
+        T value{};
+        if constexpr (std::is_integral_v<T>) {
+            std::from_chars_result result = std::from_chars(first, last, value);
+            NumericConversionStatus status = to_status(result, last);
+            if (status == NumericConversionStatus::Ok) {
+                out = value;
+            }
+            return status;
+        } else {
+#if NAYAN_SERIALIZER_FLOAT_CHARCONV
+            std::from_chars_result result = std::from_chars(first, last, value);
+            NumericConversionStatus status = to_status(result, last);
+            if (status == NumericConversionStatus::Ok) {
+                out = value;
+            }
+            return status;
+#else
+            return parse_floating_fallback(first, last, out);
+#endif
+        }
+    }
+
+    /**
+     * Append the formatted value to a string.
+     *
+     * @return NumericConversionStatus::Ok on success
+     */
+    template<typename T>
+    static NumericConversionStatus AppendNumber(T value, StdString& output) {
+        char buffer[MaxFormattedLength];
+        size_t length = 0;
+        NumericConversionStatus status = FormatNumber(value, buffer, sizeof(buffer), length);
+        if (status == NumericConversionStatus::Ok) {
+            output.append(buffer, length);
+        }
+        return status;
+    }
+
+private:
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static NumericConversionStatus to_status(const std::from_chars_result& result, const char* last) {
+        if (result.ec == std::errc::result_out_of_range) {
+            return NumericConversionStatus::OutOfRange;
+        }
+        if (result.ec != std::errc() || result.ptr != last) {
+            return NumericConversionStatus::InvalidArgument;
+        }
+        return NumericConversionStatus::Ok;
+    }
+
+#if !NAYAN_SERIALIZER_FLOAT_CHARCONV
+    // Decimal point used by snprintf/strtod in the current C locale (',' in e.g. de_DE)
+    static char locale_decimal_point() {
+        const char* point = std::localeconv()->decimal_point;
+        if (point == nullptr || point[0] == '\0' || point[1] != '\0') {
+            // Multi-byte decimal points are not translated; such locales must not be active
+            return '.';
+        }
+        return point[0];
+    }
+
+    template<typename T>
+    static NumericConversionStatus format_floating_fallback(T value, char* buffer, size_t capacity, size_t& length) {
+        // Try increasing precision until the text parses back to the same value
+        constexpr int minPrecision = std::numeric_limits<T>::digits10;
+        constexpr int maxPrecision = std::numeric_limits<T>::max_digits10;
+        char scratch[MaxFormattedLength];
+        int written = 0;
+        for (int precision = minPrecision; precision <= maxPrecision; ++precision) {
+            written = std::snprintf(scratch, sizeof(scratch), "%.*g", precision, static_cast<double>(value));
+            if (written <= 0 || static_cast<size_t>(written) >= sizeof(scratch)) {
+                return NumericConversionStatus::InvalidArgument;
+            }
+            if (value != value || static_cast<T>(std::strtod(scratch, nullptr)) == value) {
+                break;
+            }
+        }
+        if (static_cast<size_t>(written) > capacity) {
+            return NumericConversionStatus::BufferTooSmall;
+        }
+        char point = locale_decimal_point();
+        if (point != '.') {
+            char* found = static_cast<char*>(std::memchr(scratch, point, static_cast<size_t>(written)));
+            if (found != nullptr) {
+                *found = '.';
+            }
+        }
+        std::memcpy(buffer, scratch, static_cast<size_t>(written));
+        length = static_cast<size_t>(written);
+        return NumericConversionStatus::Ok;
+    }
+
+    template<typename T>
+    static NumericConversionStatus parse_floating_fallback(const char* first, const char* last, T& out) {
+        // strtod needs a null-terminated string
+        char scratch[64];
+        size_t length = static_cast<size_t>(last - first);
+        if (length >= sizeof(scratch)) {
+            return NumericConversionStatus::InvalidArgument;
+        }
+        std::memcpy(scratch, first, length);
+        scratch[length] = '\0';
+        // Same syntax as from_chars: '.' is the only decimal point and hex floats are not numbers
+        // strtod skips leading whitespace of its own, which would make "+ 5" parse as 5
+        if (is_space(scratch[0])) {
+            return NumericConversionStatus::InvalidArgument;
+        }
+        char point = locale_decimal_point();
+        for (size_t i = 0; i < length; ++i) {
+            char c = scratch[i];
+            if (c == 'x' || c == 'X' || (c == point && point != '.')) {
+                return NumericConversionStatus::InvalidArgument;
+            }
+            if (c == '.') {
+                scratch[i] = point;
+            }
+        }
+        char* end = nullptr;
+        errno = 0;
+        double value = std::strtod(scratch, &end);
+        if (end != scratch + length) {
+            return NumericConversionStatus::InvalidArgument;
+        }
+        // ERANGE also comes with subnormal results, which from_chars accepts; only overflow to
+        // infinity and underflow to zero are range errors, checked after rounding to T
+        T converted = static_cast<T>(value);
+        bool overflow = std::isinf(converted) && (errno == ERANGE || !std::isinf(value));
+        bool underflow = converted == 0 && (errno == ERANGE || value != 0);
+        if (overflow || underflow) {
+            return NumericConversionStatus::OutOfRange;
+        }
+        out = converted;
+        return NumericConversionStatus::Ok;
+    }
+#endif
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // NUMERIC_CONVERSION_UTILITY_H
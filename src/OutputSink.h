@@ -0,0 +1,185 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <StandardDefines.h>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bytes buffered by SinkOutput before they are handed to the sink
+#ifndef NAYAN_SERIALIZER_SINK_BUFFER_SIZE
+#define NAYAN_SERIALIZER_SINK_BUFFER_SIZE 4096
+#endif
+
+// FdSink (and FdSource) are available where POSIX read/write exist
+#ifndef NAYAN_SERIALIZER_POSIX_IO
+#if defined(__unix__) || defined(__APPLE__)
+#define NAYAN_SERIALIZER_POSIX_IO 1
+#else
+#define NAYAN_SERIALIZER_POSIX_IO 0
+#endif
+#endif
+
+#if NAYAN_SERIALIZER_POSIX_IO
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Sink concept
+ *
+ * SerializationUtility::Serialize(value, sink) streams JSON text into a Sink through a SinkOutput
+ * buffer, so memory use stays the same however large the value is. A Sink provides:
+ *
+ *   bool Write(const char* data, size_t length);   // false when the destination failed
+ *
+ * Sinks: OstreamSink (std::ostream), FdSink (POSIX file descriptor) and CallbackSink (user function).
+ */
+
+/**
+ * Type trait to check if a type implements the Sink concept.
+ */
+template<typename T, typename = void>
+struct is_output_sink : std::false_type {};
+
+template<typename T>
+struct is_output_sink<T, std::void_t<decltype(static_cast<bool>(std::declval<T&>().Write(std::declval<const char*>(), std::declval<size_t>())))>>
+    : std::true_type {};
+
+/**
+ * Sink over a std::ostream (file, socket wrapper, std::cout, ...).
+ */
+class OstreamSink {
+public:
+    explicit OstreamSink(std::ostream& stream) : stream_(stream) {}
+
+    bool Write(const char* data, size_t length) {
+        stream_.write(data, static_cast<std::streamsize>(length));
+        return !stream_.fail();
+    }
+
+private:
+    std::ostream& stream_;
+};
+
+#if NAYAN_SERIALIZER_POSIX_IO
+/**
+ * Sink over a POSIX file descriptor; partial writes and EINTR are retried.
+ * The descriptor is not closed.
+ */
+class FdSink {
+public:
+    explicit FdSink(int fd) : fd_(fd) {}
+
+    bool Write(const char* data, size_t length) {
+        while (length > 0) {
+            ssize_t written = ::write(fd_, data, length);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+};
+#endif
+
+/**
+ * Sink that hands every chunk to a function `bool(const char* data, size_t length)`,
+ * e.g. to send it over a network connection. Returning false stops the output.
+ *
+ *   CallbackSink sink([&](const char* data, size_t length) { return client.write(data, length) == length; });
+ */
+template<typename Callback>
+class CallbackSink {
+public:
+    explicit CallbackSink(Callback callback) : callback_(std::move(callback)) {}
+
+    bool Write(const char* data, size_t length) {
+        return callback_(data, length);
+    }
+
+private:
+    Callback callback_;
+};
+
+/**
+ * JsonWriter output that collects text in a fixed-size buffer and passes it to a Sink whenever
+ * the buffer is full. After the sink fails, further output is dropped and Flush returns false.
+ */
+template<typename Sink>
+class SinkOutput {
+public:
+    explicit SinkOutput(Sink& sink, size_t capacity = NAYAN_SERIALIZER_SINK_BUFFER_SIZE)
+        : sink_(sink), buffer_(capacity > 0 ? capacity : 1), size_(0), failed_(false) {}
+
+    void append(const char* data, size_t length) {
+        if (length > buffer_.size() - size_) {
+            flush_buffer();
+            if (length >= buffer_.size()) {
+                // Larger than the whole buffer: written through without copying
+                write_to_sink(data, length);
+                return;
+            }
+        }
+        std::memcpy(buffer_.data() + size_, data, length);
+        size_ += length;
+    }
+
+    void push_back(char c) {
+        if (size_ == buffer_.size()) {
+            flush_buffer();
+        }
+        buffer_[size_++] = c;
+    }
+
+    /**
+     * Pass the buffered text to the sink.
+     * Returns false if the sink failed at any point.
+     */
+    bool Flush() {
+        flush_buffer();
+        return !failed_;
+    }
+
+    bool Failed() const {
+        return failed_;
+    }
+
+private:
+    void flush_buffer() {
+        if (size_ != 0) {
+            write_to_sink(buffer_.data(), size_);
+            size_ = 0;
+        }
+    }
+
+    void write_to_sink(const char* data, size_t length) {
+        if (!failed_ && !sink_.Write(data, length)) {
+            failed_ = true;
+        }
+    }
+
+    Sink& sink_;
+    StdVector<char> buffer_;
+    size_t size_;
+    bool failed_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // OUTPUT_SINK_H
@@ -0,0 +1,325 @@
+#ifndef SCRATCH_DOCUMENT_POOL_H
+#define SCRATCH_DOCUMENT_POOL_H
+
+#include <ArduinoJson.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+// Number of documents kept per thread (nesting deeper than this falls back to temporary documents)
+#ifndef NAYAN_SERIALIZER_DOCUMENT_POOL_SIZE
+#define NAYAN_SERIALIZER_DOCUMENT_POOL_SIZE 4
+#endif
+
+// Bytes of freed document storage kept per thread for reuse (the rest goes back to the heap)
+#ifndef NAYAN_SERIALIZER_RETAINED_BYTES
+#define NAYAN_SERIALIZER_RETAINED_BYTES (256 * 1024)
+#endif
+
+// Single-threaded targets without TLS support can define this as empty
+#ifndef NAYAN_SERIALIZER_THREAD_LOCAL
+#define NAYAN_SERIALIZER_THREAD_LOCAL thread_local
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Per-thread counters of the scratch pool.
+ * In steady state documentMisses and storageMisses stop growing: documents and their
+ * storage are reused instead of being constructed and allocated again.
+ */
+struct ScratchPoolStats {
+    size_t documentHits = 0;    // Acquire() served by a pooled document
+    size_t documentMisses = 0;  // Acquire() had to construct a document
+    size_t storageHits = 0;     // Document storage served from retained blocks
+    size_t storageMisses = 0;   // Document storage taken from malloc
+};
+
+/**
+ * ArduinoJson allocator that keeps freed blocks for reuse instead of returning them to the heap.
+ * JsonDocument::clear() releases the document's pools and every string separately, so retention
+ * has to happen here for a cleared document to keep its capacity.
+ *
+ * Blocks are rounded up to a power of two and kept in one free list per size, so a document
+ * with thousands of strings is served again without a heap allocation, in constant time per block.
+ */
+class RetainingAllocator : public ArduinoJson::Allocator {
+public:
+    RetainingAllocator() : retained_(), retainedBytes_(0), hits_(0), misses_(0) {}
+
+    ~RetainingAllocator() {
+        Trim();
+    }
+
+    RetainingAllocator(const RetainingAllocator&) = delete;
+    RetainingAllocator& operator=(const RetainingAllocator&) = delete;
+
+    void* allocate(size_t size) override {
+        size_t sizeClass = class_of(size);
+        if (sizeClass >= ClassCount) {
+            return nullptr;
+        }
+        unsigned char* block = retained_[sizeClass];
+        if (block != nullptr) {
+            retained_[sizeClass] = read_next(block);
+            retainedBytes_ -= capacity_of(sizeClass);
+            ++hits_;
+            return block + HeaderSize;
+        }
+        block = static_cast<unsigned char*>(std::malloc(HeaderSize + capacity_of(sizeClass)));
+        if (block == nullptr) {
+            return nullptr;
+        }
+        ++misses_;
+        write_class(block, sizeClass);
+        return block + HeaderSize;
+    }
+
+    void deallocate(void* pointer) override {
+        if (pointer == nullptr) {
+            return;
+        }
+        unsigned char* block = static_cast<unsigned char*>(pointer) - HeaderSize;
+        size_t sizeClass = read_class(block);
+        size_t capacity = capacity_of(sizeClass);
+        if (retainedBytes_ + capacity > NAYAN_SERIALIZER_RETAINED_BYTES) {
+            std::free(block);
+            return;
+        }
+        write_next(block, retained_[sizeClass]);
+        retained_[sizeClass] = block;
+        retainedBytes_ += capacity;
+    }
+
+    void* reallocate(void* pointer, size_t newSize) override {
+        if (pointer == nullptr) {
+            return allocate(newSize);
+        }
+        size_t capacity = capacity_of(read_class(static_cast<unsigned char*>(pointer) - HeaderSize));
+        // Shrinking (shrinkToFit) keeps the block so its capacity is available after reuse
+        if (newSize <= capacity) {
+            return pointer;
+        }
+        void* grown = allocate(newSize);
+        if (grown != nullptr) {
+            std::memcpy(grown, pointer, capacity);
+            deallocate(pointer);
+        }
+        return grown;
+    }
+
+    /**
+     * Return every retained block to the heap.
+     */
+    void Trim() {
+        for (size_t sizeClass = 0; sizeClass < ClassCount; ++sizeClass) {
+            while (retained_[sizeClass] != nullptr) {
+                unsigned char* block = retained_[sizeClass];
+                retained_[sizeClass] = read_next(block);
+                std::free(block);
+            }
+        }
+        retainedBytes_ = 0;
+    }
+
+    size_t Hits() const {
+        return hits_;
+    }
+
+    size_t Misses() const {
+        return misses_;
+    }
+
+    void ResetStats() {
+        hits_ = 0;
+        misses_ = 0;
+    }
+
+private:
+    static constexpr size_t HeaderSize = alignof(std::max_align_t) > sizeof(size_t) ? alignof(std::max_align_t) : sizeof(size_t);
+    // Smallest block is 1 << MinClassShift bytes, large enough to hold the free-list link
+    static constexpr size_t MinClassShift = 4;
+    static constexpr size_t ClassCount = sizeof(size_t) * 8 - MinClassShift - 1;
+
+    static size_t class_of(size_t size) {
+        size_t sizeClass = 0;
+        while (sizeClass < ClassCount && capacity_of(sizeClass) < size) {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+
+    static size_t capacity_of(size_t sizeClass) {
+        return size_t(1) << (sizeClass + MinClassShift);
+    }
+
+    static void write_class(unsigned char* block, size_t sizeClass) {
+        std::memcpy(block, &sizeClass, sizeof(sizeClass));
+    }
+
+    static size_t read_class(const unsigned char* block) {
+        size_t sizeClass = 0;
+        std::memcpy(&sizeClass, block, sizeof(sizeClass));
+        return sizeClass;
+    }
+
+    // A retained block links to the next one of its size through its (unused) payload
+    static void write_next(unsigned char* block, unsigned char* next) {
+        std::memcpy(block + HeaderSize, &next, sizeof(next));
+    }
+
+    static unsigned char* read_next(const unsigned char* block) {
+        unsigned char* next = nullptr;
+        std::memcpy(&next, block + HeaderSize, sizeof(next));
+        return next;
+    }
+
+    unsigned char* retained_[ClassCount];
+    size_t retainedBytes_;
+    size_t hits_;
+    size_t misses_;
+};
+
+class ScratchDocumentPool;
+
+/**
+ * A document borrowed from the scratch pool (or owned, when the pool is exhausted or a custom
+ * allocator is used). The document is cleared and returned to the pool when the lease ends.
+ */
+class DocumentLease {
+public:
+    DocumentLease(ScratchDocumentPool* pool, size_t slot, JsonDocument* document)
+        : pool_(pool), slot_(slot), document_(document) {}
+
+    explicit DocumentLease(ArduinoJson::Allocator* allocator)
+        : pool_(nullptr), slot_(0), owned_(std::in_place, allocator) {
+        document_ = &*owned_;
+    }
+
+    DocumentLease(DocumentLease&& other)
+        : pool_(other.pool_), slot_(other.slot_), document_(other.document_) {
+        if (other.owned_.has_value()) {
+            owned_.emplace(std::move(*other.owned_));
+            document_ = &*owned_;
+        }
+        other.pool_ = nullptr;
+        other.document_ = nullptr;
+    }
+
+    DocumentLease(const DocumentLease&) = delete;
+    DocumentLease& operator=(const DocumentLease&) = delete;
+    DocumentLease& operator=(DocumentLease&&) = delete;
+
+    inline ~DocumentLease();
+
+    JsonDocument& Document() {
+        return *document_;
+    }
+
+private:
+    ScratchDocumentPool* pool_;
+    size_t slot_;
+    std::optional<JsonDocument> owned_;
+    JsonDocument* document_;
+};
+
+/**
+ * Per-thread pool of reusable JsonDocuments backed by a RetainingAllocator.
+ * SerializationUtility and the generated methods take every internal document from here
+ * (through SerializationContext::AcquireDocument) unless the context carries its own allocator.
+ */
+class ScratchDocumentPool {
+public:
+    static constexpr size_t PoolSize = NAYAN_SERIALIZER_DOCUMENT_POOL_SIZE;
+
+    /**
+     * The calling thread's pool.
+     */
+    static ScratchDocumentPool& Local() {
+        static NAYAN_SERIALIZER_THREAD_LOCAL ScratchDocumentPool pool;
+        return pool;
+    }
+
+    /**
+     * Borrow an empty document. Nested acquisitions beyond PoolSize get a temporary document
+     * that still draws its storage from the thread's retained blocks.
+     */
+    DocumentLease Acquire() {
+        for (size_t slot = 0; slot < PoolSize; ++slot) {
+            if (!inUse_[slot]) {
+                inUse_[slot] = true;
+                if (documents_[slot].has_value()) {
+                    ++documentHits_;
+                } else {
+                    ++documentMisses_;
+                    documents_[slot].emplace(&allocator_);
+                }
+                return DocumentLease(this, slot, &*documents_[slot]);
+            }
+        }
+        ++documentMisses_;
+        return DocumentLease(&allocator_);
+    }
+
+    /**
+     * Counters for the calling thread since the last ResetStats().
+     */
+    ScratchPoolStats Stats() const {
+        ScratchPoolStats stats;
+        stats.documentHits = documentHits_;
+        stats.documentMisses = documentMisses_;
+        stats.storageHits = allocator_.Hits();
+        stats.storageMisses = allocator_.Misses();
+        return stats;
+    }
+
+    void ResetStats() {
+        documentHits_ = 0;
+        documentMisses_ = 0;
+        allocator_.ResetStats();
+    }
+
+    /**
+     * Release the retained storage of idle documents back to the heap.
+     */
+    void Trim() {
+        for (size_t slot = 0; slot < PoolSize; ++slot) {
+            if (!inUse_[slot]) {
+                documents_[slot].reset();
+            }
+        }
+        allocator_.Trim();
+    }
+
+private:
+    friend class DocumentLease;
+
+    ScratchDocumentPool() : inUse_(), documentHits_(0), documentMisses_(0) {}
+
+    void release(size_t slot) {
+        // clear() hands the pools back to the allocator, which keeps them for the next request
+        documents_[slot]->clear();
+        inUse_[slot] = false;
+    }
+
+    // Declared first so it outlives the documents that allocate from it
+    RetainingAllocator allocator_;
+    std::optional<JsonDocument> documents_[PoolSize];
+    bool inUse_[PoolSize];
+    size_t documentHits_;
+    size_t documentMisses_;
+};
+
+inline DocumentLease::~DocumentLease() {
+    if (pool_ != nullptr) {
+        pool_->release(slot_);
+    }
+}
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // SCRATCH_DOCUMENT_POOL_H
@@ -0,0 +1,67 @@
+#ifndef SERIALIZATION_CONTEXT_H
+#define SERIALIZATION_CONTEXT_H
+
+#include <ArduinoJson.h>
+#include "ScratchDocumentPool.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Per-call settings passed down through SerializationUtility and the generated methods.
+ * Every JsonDocument used on behalf of a call comes from AcquireDocument(), so its
+ * storage is taken from the context's allocator (the thread's scratch pool when none is set).
+ *
+ * The context does not own the allocator; it must outlive every document created from it.
+ */
+class SerializationContext {
+public:
+    SerializationContext() : allocator_(nullptr) {}
+
+    explicit SerializationContext(ArduinoJson::Allocator* allocator) : allocator_(allocator) {}
+
+    /**
+     * Allocator used for document storage, or nullptr for ArduinoJson's default heap allocator.
+     */
+    ArduinoJson::Allocator* GetAllocator() const {
+        return allocator_;
+    }
+
+    /**
+     * Create an empty document backed by this context's allocator.
+     */
+    JsonDocument CreateDocument() const {
+        if (allocator_ != nullptr) {
+            return JsonDocument(allocator_);
+        }
+        return JsonDocument();
+    }
+
+    /**
+     * Borrow an empty document for the duration of a call.
+     * Without a custom allocator the document comes from the calling thread's ScratchDocumentPool,
+     * so its storage is reused across calls instead of going back to the heap.
+     */
+    DocumentLease AcquireDocument() const {
+        if (allocator_ != nullptr) {
+            return DocumentLease(allocator_);
+        }
+        return ScratchDocumentPool::Local().Acquire();
+    }
+
+    /**
+     * Shared context without a custom allocator (used by the overloads without a context).
+     */
+    static const SerializationContext& Default() {
+        static const SerializationContext context;
+        return context;
+    }
+
+private:
+    ArduinoJson::Allocator* allocator_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATION_CONTEXT_H
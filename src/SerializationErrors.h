@@ -0,0 +1,109 @@
+#ifndef SERIALIZATION_ERRORS_H
+#define SERIALIZATION_ERRORS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Exception support detection.
+// With -fno-exceptions the throwing APIs (Deserialize, FromJson, ...) abort on error;
+// use the TryDeserialize family to get error codes instead.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define NAYAN_SERIALIZER_EXCEPTIONS 1
+#define NAYAN_SERIALIZER_THROW(exception) throw exception
+#else
+#define NAYAN_SERIALIZER_EXCEPTIONS 0
+#define NAYAN_SERIALIZER_THROW(exception) ::abort()
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Error codes reported by the non-throwing TryDeserialize family.
+ */
+enum class DeserializeError : uint8_t {
+    Ok,
+    EmptyInput,        // Input contained no value
+    IncompleteInput,   // Input ended in the middle of a value
+    InvalidInput,      // Input is not valid JSON
+    NoMemory,          // Document allocation failed
+    TooDeep,           // Nesting limit exceeded
+    TypeMismatch,      // JSON value has the wrong type for the target field
+    OutOfRange,        // Number does not fit in the target type
+    SizeMismatch,      // JSON array length does not match a fixed-size container
+    UnknownEnumValue,  // String does not name a value of the target enum
+    ValidationFailed,  // A validation macro (NotNull, NotBlank, ...) rejected a field
+    InvalidBase64,     // String is not valid base64 for a byte-buffer field (see Base64.h)
+    IoError            // The input source (stream, file descriptor) reported a read error
+};
+
+/**
+ * Result of a TryDeserialize call.
+ * Holds no owned memory: field names point to static strings in generated code.
+ */
+struct DeserializeStatus {
+    DeserializeError error = DeserializeError::Ok;
+    // Byte offset in the input: where a syntax error was detected, or where a rejected value
+    // starts (0 when not known, e.g. validation failures and values read from a document)
+    size_t offset = 0;
+    // Name of the innermost field that failed, or nullptr
+    const char* field = nullptr;
+
+    static DeserializeStatus Success() {
+        return DeserializeStatus();
+    }
+
+    static DeserializeStatus Failure(DeserializeError error, const char* field = nullptr, size_t offset = 0) {
+        DeserializeStatus status;
+        status.error = error;
+        status.field = field;
+        status.offset = offset;
+        return status;
+    }
+
+    bool ok() const {
+        return error == DeserializeError::Ok;
+    }
+
+    explicit operator bool() const {
+        return ok();
+    }
+
+    /**
+     * Attach a field name if no inner field has been recorded yet.
+     */
+    DeserializeStatus& InField(const char* fieldName) {
+        if (field == nullptr) {
+            field = fieldName;
+        }
+        return *this;
+    }
+
+    /**
+     * Static description of the error code.
+     */
+    const char* c_str() const {
+        switch (error) {
+            case DeserializeError::Ok: return "Ok";
+            case DeserializeError::EmptyInput: return "EmptyInput";
+            case DeserializeError::IncompleteInput: return "IncompleteInput";
+            case DeserializeError::InvalidInput: return "InvalidInput";
+            case DeserializeError::NoMemory: return "NoMemory";
+            case DeserializeError::TooDeep: return "TooDeep";
+            case DeserializeError::TypeMismatch: return "TypeMismatch";
+            case DeserializeError::OutOfRange: return "OutOfRange";
+            case DeserializeError::SizeMismatch: return "SizeMismatch";
+            case DeserializeError::UnknownEnumValue: return "UnknownEnumValue";
+            case DeserializeError::ValidationFailed: return "ValidationFailed";
+            case DeserializeError::InvalidBase64: return "InvalidBase64";
+            case DeserializeError::IoError: return "IoError";
+        }
+        return "Unknown";
+    }
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATION_ERRORS_H
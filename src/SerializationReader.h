@@ -0,0 +1,1119 @@
+#ifndef SERIALIZATION_READER_H
+#define SERIALIZATION_READER_H
+
+#include <StandardDefines.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "JsonStructuralIndex.h"
+#include "NumericConversionUtility.h"
+#include "SerializationErrors.h"
+#include "StringScanner.h"
+
+// Maximum depth of nested objects/arrays accepted by the readers (same default as ArduinoJson)
+#ifndef NAYAN_SERIALIZER_NESTING_LIMIT
+#define NAYAN_SERIALIZER_NESTING_LIMIT 10
+#endif
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Kind of the next value in the input.
+ */
+enum class TokenType : uint8_t {
+    End,      // No more input
+    Null,
+    Bool,
+    Number,
+    String,
+    Object,
+    Array,
+    Invalid   // Not the start of a value this reader understands
+};
+
+/**
+ * Reader concept
+ *
+ * SerializationUtility::Read and the generated ReadFrom methods consume input through a Reader,
+ * a pull parser that never builds a document. A Reader provides:
+ *
+ *   TokenType Peek();
+ *   DeserializeError BeginObject();
+ *   DeserializeError NextMember(bool& found, const char*& key, size_t& keyLength);  // found == false after the last member
+ *   DeserializeError BeginArray();
+ *   DeserializeError NextElement(bool& found);                                      // found == false after the last element
+ *   DeserializeError ReadNull();
+ *   DeserializeError ReadBool(bool& value);
+ *   DeserializeError ReadInt(int64_t& value);
+ *   DeserializeError ReadUInt(uint64_t& value);
+ *   DeserializeError ReadDouble(double& value);
+ *   DeserializeError ReadString(const char*& data, size_t& length);
+ *   DeserializeError Skip();                                                        // skip one value of any type
+ *   template<typename T> bool ReadNumbers(StdVector<T>& values);                   // whole array of plain numbers, see below
+ *   size_t Position() const;                                                        // byte offset for error reports
+ *
+ * The Read* methods return TypeMismatch (or OutOfRange) without consuming anything when the next
+ * value has another type, so the caller can try a different one. Keys and strings returned by
+ * NextMember/ReadString stay valid until the next call of the same method.
+ * ReadNumbers appends an array whose elements are all numbers that fit T (integers for integer
+ * types), reserving its size up front; for anything else it returns false without consuming
+ * input, and the caller reads the array element by element.
+ *
+ * Backends: JsonReader and MsgPackReader.
+ */
+
+/**
+ * Pull parser over JSON text.
+ * With a JsonStructuralIndex of the same text, string ends come from its quote positions instead
+ * of a scan of the string's bytes. Skipped values are validated exactly like read ones with or
+ * without an index, so whether an input is accepted never depends on its size.
+ */
+class JsonReader {
+public:
+    JsonReader(const char* data, size_t length)
+        : data_(data), length_(length), position_(0), depth_(0), first_(true), index_(nullptr), indexCursor_(0) {}
+
+    JsonReader(const char* data, size_t length, const JsonStructuralIndex& index)
+        : data_(data), length_(length), position_(0), depth_(0), first_(true), index_(&index), indexCursor_(0) {}
+
+    TokenType Peek() {
+        skip_whitespace();
+        if (position_ >= length_) {
+            return TokenType::End;
+        }
+        switch (data_[position_]) {
+            case '{': return TokenType::Object;
+            case '[': return TokenType::Array;
+            case '"': return TokenType::String;
+            case 'n': return TokenType::Null;
+            case 't':
+            case 'f': return TokenType::Bool;
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9': return TokenType::Number;
+            default: return TokenType::Invalid;
+        }
+    }
+
+    DeserializeError BeginObject() {
+        return begin_container(TokenType::Object);
+    }
+
+    DeserializeError NextMember(bool& found, const char*& key, size_t& keyLength) {
+        DeserializeError error = next_entry('}', found);
+        if (error != DeserializeError::Ok || !found) {
+            return error;
+        }
+        if (position_ >= length_) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (data_[position_] != '"') {
+            return DeserializeError::InvalidInput;
+        }
+        error = read_quoted(key, keyLength, keyScratch_);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        return expect(':');
+    }
+
+    DeserializeError BeginArray() {
+        return begin_container(TokenType::Array);
+    }
+
+    DeserializeError NextElement(bool& found) {
+        return next_entry(']', found);
+    }
+
+    DeserializeError ReadNull() {
+        TokenType token = Peek();
+        if (token != TokenType::Null) {
+            return mismatch(token);
+        }
+        return expect_literal("null", 4);
+    }
+
+    DeserializeError ReadBool(bool& value) {
+        TokenType token = Peek();
+        if (token != TokenType::Bool) {
+            return mismatch(token);
+        }
+        value = data_[position_] == 't';
+        return value ? expect_literal("true", 4) : expect_literal("false", 5);
+    }
+
+    DeserializeError ReadInt(int64_t& value) {
+        const char* last = nullptr;
+        bool isInteger = false;
+        DeserializeError error = scan_number(last, isInteger);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if (!isInteger) {
+            return DeserializeError::TypeMismatch;
+        }
+        std::from_chars_result result = std::from_chars(data_ + position_, last, value);
+        if (result.ec != std::errc()) {
+            return DeserializeError::OutOfRange;
+        }
+        position_ = static_cast<size_t>(last - data_);
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadUInt(uint64_t& value) {
+        const char* last = nullptr;
+        bool isInteger = false;
+        DeserializeError error = scan_number(last, isInteger);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if (!isInteger) {
+            return DeserializeError::TypeMismatch;
+        }
+        const char* first = data_ + position_;
+        if (*first == '-') {
+            // "-0" is the only negative text that fits
+            if (last - first != 2 || first[1] != '0') {
+                return DeserializeError::OutOfRange;
+            }
+            ++first;
+        }
+        std::from_chars_result result = std::from_chars(first, last, value);
+        if (result.ec != std::errc()) {
+            return DeserializeError::OutOfRange;
+        }
+        position_ = static_cast<size_t>(last - data_);
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadDouble(double& value) {
+        const char* last = nullptr;
+        bool isInteger = false;
+        DeserializeError error = scan_number(last, isInteger);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        NumericConversionStatus status = NumericConversionUtility::ParseNumber(data_ + position_, last, value);
+        if (status == NumericConversionStatus::OutOfRange) {
+            return DeserializeError::OutOfRange;
+        }
+        if (status != NumericConversionStatus::Ok) {
+            return DeserializeError::InvalidInput;
+        }
+        position_ = static_cast<size_t>(last - data_);
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadString(const char*& data, size_t& length) {
+        TokenType token = Peek();
+        if (token != TokenType::String) {
+            return mismatch(token);
+        }
+        return read_quoted(data, length, valueScratch_);
+    }
+
+    DeserializeError Skip() {
+        TokenType token = Peek();
+        switch (token) {
+            case TokenType::Null:
+                return ReadNull();
+            case TokenType::Bool: {
+                bool ignored = false;
+                return ReadBool(ignored);
+            }
+            case TokenType::Number: {
+                const char* last = nullptr;
+                bool isInteger = false;
+                DeserializeError error = scan_number(last, isInteger);
+                if (error == DeserializeError::Ok) {
+                    position_ = static_cast<size_t>(last - data_);
+                }
+                return error;
+            }
+            case TokenType::String: {
+                const char* ignored = nullptr;
+                size_t length = 0;
+                return skip_quoted(ignored, length);
+            }
+            case TokenType::Object: {
+                DeserializeError error = BeginObject();
+                bool found = true;
+                while (error == DeserializeError::Ok) {
+                    const char* key = nullptr;
+                    size_t keyLength = 0;
+                    error = NextMember(found, key, keyLength);
+                    if (error != DeserializeError::Ok || !found) {
+                        break;
+                    }
+                    error = Skip();
+                }
+                return error;
+            }
+            case TokenType::Array: {
+                DeserializeError error = BeginArray();
+                bool found = true;
+                while (error == DeserializeError::Ok) {
+                    error = NextElement(found);
+                    if (error != DeserializeError::Ok || !found) {
+                        break;
+                    }
+                    error = Skip();
+                }
+                return error;
+            }
+            case TokenType::End:
+                return DeserializeError::IncompleteInput;
+            default:
+                return DeserializeError::InvalidInput;
+        }
+    }
+
+    template<typename T>
+    bool ReadNumbers(StdVector<T>& values) {
+        if (Peek() != TokenType::Array || depth_ >= NAYAN_SERIALIZER_NESTING_LIMIT) {
+            return false;
+        }
+        size_t start = position_;
+        size_t initialSize = values.size();
+        values.reserve(initialSize + size_hint());
+        ++position_;
+        skip_whitespace();
+        if (position_ < length_ && data_[position_] == ']') {
+            ++position_;
+            first_ = false;
+            return true;
+        }
+        while (true) {
+            T value{};
+            if (!read_plain_number(value)) {
+                break;
+            }
+            values.push_back(value);
+            skip_whitespace();
+            if (position_ >= length_) {
+                break;
+            }
+            char c = data_[position_++];
+            if (c == ']') {
+                first_ = false;
+                return true;
+            }
+            if (c != ',') {
+                break;
+            }
+        }
+        position_ = start;
+        values.resize(initialSize);
+        return false;
+    }
+
+    /**
+     * Check that only whitespace follows the value that was read.
+     */
+    DeserializeError Finish() {
+        return Peek() == TokenType::End ? DeserializeError::Ok : DeserializeError::InvalidInput;
+    }
+
+    size_t Position() const {
+        return position_;
+    }
+
+private:
+    void skip_whitespace() {
+        while (position_ < length_) {
+            char c = data_[position_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++position_;
+        }
+    }
+
+    DeserializeError mismatch(TokenType token) const {
+        if (token == TokenType::End) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (token == TokenType::Invalid) {
+            return DeserializeError::InvalidInput;
+        }
+        return DeserializeError::TypeMismatch;
+    }
+
+    DeserializeError expect(char c) {
+        skip_whitespace();
+        if (position_ >= length_) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (data_[position_] != c) {
+            return DeserializeError::InvalidInput;
+        }
+        ++position_;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError expect_literal(const char* literal, size_t length) {
+        size_t available = length_ - position_;
+        size_t compared = available < length ? available : length;
+        if (std::memcmp(data_ + position_, literal, compared) != 0) {
+            return DeserializeError::InvalidInput;
+        }
+        if (compared < length) {
+            return DeserializeError::IncompleteInput;
+        }
+        position_ += length;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError begin_container(TokenType type) {
+        TokenType token = Peek();
+        if (token != type) {
+            return mismatch(token);
+        }
+        if (depth_ >= NAYAN_SERIALIZER_NESTING_LIMIT) {
+            return DeserializeError::TooDeep;
+        }
+        ++depth_;
+        ++position_;
+        first_ = true;
+        return DeserializeError::Ok;
+    }
+
+    // Moves to the next member/element: consumes the separating comma, or the closing bracket
+    // (found == false). A nested container that was read completely leaves first_ false.
+    DeserializeError next_entry(char close, bool& found) {
+        skip_whitespace();
+        if (position_ >= length_) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (data_[position_] == close) {
+            ++position_;
+            --depth_;
+            first_ = false;
+            found = false;
+            return DeserializeError::Ok;
+        }
+        if (!first_) {
+            if (data_[position_] != ',') {
+                return DeserializeError::InvalidInput;
+            }
+            ++position_;
+            skip_whitespace();
+            // No trailing comma before the closing bracket
+            if (position_ < length_ && data_[position_] == close) {
+                return DeserializeError::InvalidInput;
+            }
+        }
+        first_ = false;
+        found = true;
+        return DeserializeError::Ok;
+    }
+
+    // Validates the number at the current position without consuming it
+    DeserializeError scan_number(const char*& last, bool& isInteger) {
+        TokenType token = Peek();
+        if (token != TokenType::Number) {
+            return mismatch(token);
+        }
+        const char* p = data_ + position_;
+        const char* end = data_ + length_;
+        isInteger = true;
+        if (*p == '-') {
+            ++p;
+        }
+        if (p == end) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (*p == '0') {
+            ++p;
+        } else if (*p >= '1' && *p <= '9') {
+            while (p < end && *p >= '0' && *p <= '9') {
+                ++p;
+            }
+        } else {
+            return DeserializeError::InvalidInput;
+        }
+        if (p < end && *p == '.') {
+            isInteger = false;
+            ++p;
+            const char* digits = p;
+            while (p < end && *p >= '0' && *p <= '9') {
+                ++p;
+            }
+            if (p == digits) {
+                return p == end ? DeserializeError::IncompleteInput : DeserializeError::InvalidInput;
+            }
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            isInteger = false;
+            ++p;
+            if (p < end && (*p == '+' || *p == '-')) {
+                ++p;
+            }
+            const char* digits = p;
+            while (p < end && *p >= '0' && *p <= '9') {
+                ++p;
+            }
+            if (p == digits) {
+                return p == end ? DeserializeError::IncompleteInput : DeserializeError::InvalidInput;
+            }
+        }
+        last = p;
+        return DeserializeError::Ok;
+    }
+
+    // Commas before the first closing bracket, plus one: exact for a flat array of numbers and
+    // an upper bound otherwise, so only good for reserve
+    size_t size_hint() const {
+        const char* first = data_ + position_ + 1;
+        const void* close = std::memchr(first, ']', length_ - position_ - 1);
+        if (close == nullptr) {
+            return 0;
+        }
+        return static_cast<size_t>(std::count(first, static_cast<const char*>(close), ',')) + 1;
+    }
+
+    // Number that converts to T without a type or range error; nothing is consumed otherwise
+    template<typename T>
+    bool read_plain_number(T& value) {
+        skip_whitespace();
+        if constexpr (std::is_integral_v<T>) {
+            // Digits are accumulated while they are validated; fractions, exponents, 20+ digit
+            // numbers and negative text for unsigned types ("-0" included) are left to Read
+            const char* p = data_ + position_;
+            const char* end = data_ + length_;
+            bool isNegative = p < end && *p == '-';
+            if (isNegative) {
+                if constexpr (std::is_unsigned_v<T>) {
+                    return false;
+                }
+                ++p;
+            }
+            const char* digits = p;
+            uint64_t magnitude = 0;
+            while (p < end && static_cast<unsigned char>(*p - '0') < 10) {
+                if (p - digits == 19) {
+                    return false;
+                }
+                magnitude = magnitude * 10 + static_cast<uint64_t>(*p - '0');
+                ++p;
+            }
+            if (p == digits || (*digits == '0' && p - digits > 1)) {
+                return false;
+            }
+            if (p < end && (*p == '.' || *p == 'e' || *p == 'E')) {
+                return false;
+            }
+            if (isNegative) {
+                if (magnitude > static_cast<uint64_t>(std::numeric_limits<T>::max()) + 1) {
+                    return false;
+                }
+                value = static_cast<T>(static_cast<int64_t>(~magnitude + 1));
+            } else {
+                if (magnitude > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                    return false;
+                }
+                value = static_cast<T>(magnitude);
+            }
+            position_ = static_cast<size_t>(p - data_);
+            return true;
+        } else {
+            const char* last = nullptr;
+            bool isInteger = false;
+            if (scan_number(last, isInteger) != DeserializeError::Ok) {
+                return false;
+            }
+            const char* first = data_ + position_;
+            double parsed = 0;
+            if (NumericConversionUtility::ParseNumber(first, last, parsed) != NumericConversionStatus::Ok) {
+                return false;
+            }
+            if (parsed > static_cast<double>(std::numeric_limits<T>::max()) ||
+                parsed < -static_cast<double>(std::numeric_limits<T>::max())) {
+                return false;
+            }
+            value = static_cast<T>(parsed);
+            position_ = static_cast<size_t>(last - data_);
+            return true;
+        }
+    }
+
+    // Reads the string at the current position (opening quote); strings without escapes are
+    // returned in place, others are decoded into `scratch`
+    DeserializeError read_quoted(const char*& data, size_t& length, StdString& scratch) {
+        const char* first = data_ + position_ + 1;
+        const char* end = data_ + length_;
+        const char* p = first;
+        if (index_ != nullptr) {
+            // The closing quote is the next indexed position; only a backslash needs decoding
+            const char* close = data_ + indexed_position(position_ + 1);
+            const void* backslash = std::memchr(first, '\\', static_cast<size_t>(close - first));
+            p = backslash != nullptr ? static_cast<const char*>(backslash) : close;
+        } else {
+            p += StringScanner::FindQuoteOrBackslash(first, static_cast<size_t>(end - first));
+        }
+        if (p == end) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (*p == '"') {
+            data = first;
+            length = static_cast<size_t>(p - first);
+            position_ = static_cast<size_t>(p + 1 - data_);
+            return DeserializeError::Ok;
+        }
+
+        scratch.assign(first, static_cast<size_t>(p - first));
+        while (p < end && *p != '"') {
+            if (*p != '\\') {
+                size_t run = StringScanner::FindQuoteOrBackslash(p, static_cast<size_t>(end - p));
+                scratch.append(p, run);
+                p += run;
+                continue;
+            }
+            DeserializeError error = decode_escape(p, end, scratch);
+            if (error != DeserializeError::Ok) {
+                return error;
+            }
+        }
+        if (p == end) {
+            return DeserializeError::IncompleteInput;
+        }
+        data = scratch.data();
+        length = scratch.size();
+        position_ = static_cast<size_t>(p + 1 - data_);
+        return DeserializeError::Ok;
+    }
+
+    // First indexed position at or after `from` (the end of the input when there is none).
+    // Positions only move forward, so the cursor is advanced instead of searched.
+    size_t indexed_position(size_t from) {
+        const uint32_t* positions = index_->Positions();
+        size_t count = index_->Count();
+        while (indexCursor_ < count && positions[indexCursor_] < from) {
+            ++indexCursor_;
+        }
+        return indexCursor_ < count ? positions[indexCursor_] : length_;
+    }
+
+    DeserializeError skip_quoted(const char*& data, size_t& length) {
+        // Decoding is cheap compared to a second scanner; the result is simply ignored
+        return read_quoted(data, length, valueScratch_);
+    }
+
+    // Decodes the escape sequence at p (a backslash) and advances past it
+    static DeserializeError decode_escape(const char*& p, const char* end, StdString& output) {
+        if (end - p < 2) {
+            return DeserializeError::IncompleteInput;
+        }
+        char c = p[1];
+        p += 2;
+        switch (c) {
+            case '"': output.push_back('"'); return DeserializeError::Ok;
+            case '\\': output.push_back('\\'); return DeserializeError::Ok;
+            case '/': output.push_back('/'); return DeserializeError::Ok;
+            case 'b': output.push_back('\b'); return DeserializeError::Ok;
+            case 'f': output.push_back('\f'); return DeserializeError::Ok;
+            case 'n': output.push_back('\n'); return DeserializeError::Ok;
+            case 'r': output.push_back('\r'); return DeserializeError::Ok;
+            case 't': output.push_back('\t'); return DeserializeError::Ok;
+            case 'u': break;
+            default: return DeserializeError::InvalidInput;
+        }
+
+        uint32_t codepoint = 0;
+        DeserializeError error = read_hex4(p, end, codepoint);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        // Surrogate pair
+        if (codepoint >= 0xD800 && codepoint < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+            const char* low = p + 2;
+            uint32_t lowSurrogate = 0;
+            if (read_hex4(low, end, lowSurrogate) == DeserializeError::Ok && lowSurrogate >= 0xDC00 && lowSurrogate < 0xE000) {
+                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                p = low;
+            }
+        }
+        append_utf8(codepoint, output);
+        return DeserializeError::Ok;
+    }
+
+    static DeserializeError read_hex4(const char*& p, const char* end, uint32_t& value) {
+        if (end - p < 4) {
+            return DeserializeError::IncompleteInput;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = p[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return DeserializeError::InvalidInput;
+            }
+        }
+        p += 4;
+        return DeserializeError::Ok;
+    }
+
+    static void append_utf8(uint32_t codepoint, StdString& output) {
+        if (codepoint < 0x80) {
+            output.push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else if (codepoint < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    const char* data_;
+    size_t length_;
+    size_t position_;
+    size_t depth_;
+    bool first_;
+    const JsonStructuralIndex* index_;
+    size_t indexCursor_;
+    StdString keyScratch_;
+    StdString valueScratch_;
+};
+
+/**
+ * Pull parser over MessagePack.
+ */
+class MsgPackReader {
+public:
+    MsgPackReader(const char* data, size_t length) : data_(data), length_(length), position_(0), depth_(0) {}
+
+    TokenType Peek() {
+        if (position_ >= length_) {
+            return TokenType::End;
+        }
+        uint8_t type = byte_at(position_);
+        if (type <= 0x7f || type >= 0xe0 || (type >= 0xca && type <= 0xd3)) {
+            return TokenType::Number;
+        }
+        if ((type >= 0x80 && type <= 0x8f) || type == 0xde || type == 0xdf) {
+            return TokenType::Object;
+        }
+        if ((type >= 0x90 && type <= 0x9f) || type == 0xdc || type == 0xdd) {
+            return TokenType::Array;
+        }
+        if ((type >= 0xa0 && type <= 0xbf) || (type >= 0xd9 && type <= 0xdb)) {
+            return TokenType::String;
+        }
+        if (type == 0xc0) {
+            return TokenType::Null;
+        }
+        if (type == 0xc2 || type == 0xc3) {
+            return TokenType::Bool;
+        }
+        return TokenType::Invalid;
+    }
+
+    DeserializeError BeginObject() {
+        return begin_container(TokenType::Object, 0x80, 0xde);
+    }
+
+    DeserializeError NextMember(bool& found, const char*& key, size_t& keyLength) {
+        if (!next_entry(found)) {
+            return DeserializeError::Ok;
+        }
+        // Only string keys are supported (same as deserializeMsgPack)
+        TokenType token = Peek();
+        if (token != TokenType::String) {
+            return token == TokenType::End ? DeserializeError::IncompleteInput : DeserializeError::InvalidInput;
+        }
+        return ReadString(key, keyLength);
+    }
+
+    DeserializeError BeginArray() {
+        return begin_container(TokenType::Array, 0x90, 0xdc);
+    }
+
+    DeserializeError NextElement(bool& found) {
+        next_entry(found);
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadNull() {
+        TokenType token = Peek();
+        if (token != TokenType::Null) {
+            return mismatch(token);
+        }
+        ++position_;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadBool(bool& value) {
+        TokenType token = Peek();
+        if (token != TokenType::Bool) {
+            return mismatch(token);
+        }
+        value = byte_at(position_) == 0xc3;
+        ++position_;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadInt(int64_t& value) {
+        bool isNegative = false;
+        uint64_t magnitude = 0;
+        size_t size = 0;
+        DeserializeError error = decode_integer(isNegative, magnitude, size);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if (isNegative) {
+            value = static_cast<int64_t>(magnitude);
+        } else {
+            if (magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                return DeserializeError::OutOfRange;
+            }
+            value = static_cast<int64_t>(magnitude);
+        }
+        position_ += size;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadUInt(uint64_t& value) {
+        bool isNegative = false;
+        uint64_t raw = 0;
+        size_t size = 0;
+        DeserializeError error = decode_integer(isNegative, raw, size);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        if (isNegative) {
+            return DeserializeError::OutOfRange;
+        }
+        value = raw;
+        position_ += size;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadDouble(double& value) {
+        TokenType token = Peek();
+        if (token != TokenType::Number) {
+            return mismatch(token);
+        }
+        uint8_t type = byte_at(position_);
+        if (type == 0xca) {
+            if (length_ - position_ < 5) {
+                return DeserializeError::IncompleteInput;
+            }
+            uint32_t bits = static_cast<uint32_t>(load_big_endian(position_ + 1, 4));
+            float narrowed = 0;
+            std::memcpy(&narrowed, &bits, sizeof(bits));
+            value = narrowed;
+            position_ += 5;
+            return DeserializeError::Ok;
+        }
+        if (type == 0xcb) {
+            if (length_ - position_ < 9) {
+                return DeserializeError::IncompleteInput;
+            }
+            uint64_t bits = load_big_endian(position_ + 1, 8);
+            std::memcpy(&value, &bits, sizeof(bits));
+            position_ += 9;
+            return DeserializeError::Ok;
+        }
+        bool isNegative = false;
+        uint64_t raw = 0;
+        size_t size = 0;
+        DeserializeError error = decode_integer(isNegative, raw, size);
+        if (error != DeserializeError::Ok) {
+            return error;
+        }
+        value = isNegative ? static_cast<double>(static_cast<int64_t>(raw)) : static_cast<double>(raw);
+        position_ += size;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError ReadString(const char*& data, size_t& length) {
+        TokenType token = Peek();
+        if (token != TokenType::String) {
+            return mismatch(token);
+        }
+        uint8_t type = byte_at(position_);
+        size_t headerLength = 1;
+        uint64_t size = 0;
+        if (type >= 0xa0 && type <= 0xbf) {
+            size = type & 0x1f;
+        } else {
+            headerLength = 1 + (static_cast<size_t>(1) << (type - 0xd9));
+            if (length_ - position_ < headerLength) {
+                return DeserializeError::IncompleteInput;
+            }
+            size = load_big_endian(position_ + 1, headerLength - 1);
+        }
+        if (length_ - position_ - headerLength < size) {
+            return DeserializeError::IncompleteInput;
+        }
+        data = data_ + position_ + headerLength;
+        length = static_cast<size_t>(size);
+        position_ += headerLength + length;
+        return DeserializeError::Ok;
+    }
+
+    DeserializeError Skip() {
+        if (position_ >= length_) {
+            return DeserializeError::IncompleteInput;
+        }
+        uint8_t type = byte_at(position_);
+        TokenType token = Peek();
+        switch (token) {
+            case TokenType::Null:
+            case TokenType::Bool:
+                ++position_;
+                return DeserializeError::Ok;
+            case TokenType::Number: {
+                double ignored = 0;
+                return ReadDouble(ignored);
+            }
+            case TokenType::String: {
+                const char* ignored = nullptr;
+                size_t length = 0;
+                return ReadString(ignored, length);
+            }
+            case TokenType::Object:
+            case TokenType::Array: {
+                bool isObject = token == TokenType::Object;
+                DeserializeError error = isObject ? BeginObject() : BeginArray();
+                bool found = true;
+                while (error == DeserializeError::Ok) {
+                    next_entry(found);
+                    if (!found) {
+                        break;
+                    }
+                    // Keys are values of their own in MessagePack
+                    error = isObject ? Skip() : DeserializeError::Ok;
+                    if (error == DeserializeError::Ok) {
+                        error = Skip();
+                    }
+                }
+                return error;
+            }
+            default:
+                break;
+        }
+        // Binary and extension types
+        size_t headerLength = 0;
+        uint64_t size = 0;
+        if (type >= 0xc4 && type <= 0xc6) {
+            headerLength = 1 + (static_cast<size_t>(1) << (type - 0xc4));
+        } else if (type >= 0xc7 && type <= 0xc9) {
+            headerLength = 2 + (static_cast<size_t>(1) << (type - 0xc7));
+        } else if (type >= 0xd4 && type <= 0xd8) {
+            headerLength = 2;
+            size = static_cast<uint64_t>(1) << (type - 0xd4);
+        } else {
+            return DeserializeError::InvalidInput;
+        }
+        if (length_ - position_ < headerLength) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (type <= 0xc9) {
+            // The length follows the type byte; extension types then have their type code
+            size_t lengthBytes = type <= 0xc6 ? headerLength - 1 : headerLength - 2;
+            size = load_big_endian(position_ + 1, lengthBytes);
+        }
+        if (length_ - position_ - headerLength < size) {
+            return DeserializeError::IncompleteInput;
+        }
+        position_ += headerLength + static_cast<size_t>(size);
+        return DeserializeError::Ok;
+    }
+
+    template<typename T>
+    bool ReadNumbers(StdVector<T>& values) {
+        size_t start = position_;
+        size_t initialSize = values.size();
+        if (BeginArray() != DeserializeError::Ok) {
+            position_ = start;
+            return false;
+        }
+        uint32_t count = remaining_[--depth_];
+        // Every element takes one byte at least, so a corrupt header cannot reserve more than the input
+        if (count <= length_ - position_) {
+            values.reserve(initialSize + count);
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            T value{};
+            if (!read_plain_number(value)) {
+                position_ = start;
+                values.resize(initialSize);
+                return false;
+            }
+            values.push_back(value);
+        }
+        return true;
+    }
+
+    /**
+     * Check that nothing follows the value that was read.
+     */
+    DeserializeError Finish() {
+        return position_ >= length_ ? DeserializeError::Ok : DeserializeError::InvalidInput;
+    }
+
+    size_t Position() const {
+        return position_;
+    }
+
+private:
+    uint8_t byte_at(size_t position) const {
+        return static_cast<uint8_t>(data_[position]);
+    }
+
+    uint64_t load_big_endian(size_t position, size_t bytes) const {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value = (value << 8) | byte_at(position + i);
+        }
+        return value;
+    }
+
+    DeserializeError mismatch(TokenType token) const {
+        if (token == TokenType::End) {
+            return DeserializeError::IncompleteInput;
+        }
+        if (token == TokenType::Invalid) {
+            return DeserializeError::InvalidInput;
+        }
+        return DeserializeError::TypeMismatch;
+    }
+
+    DeserializeError begin_container(TokenType type, uint8_t fixBase, uint8_t type16) {
+        TokenType token = Peek();
+        if (token != type) {
+            return mismatch(token);
+        }
+        if (depth_ >= NAYAN_SERIALIZER_NESTING_LIMIT) {
+            return DeserializeError::TooDeep;
+        }
+        uint8_t header = byte_at(position_);
+        size_t headerLength = 1;
+        uint64_t count = 0;
+        if (header >= fixBase && header <= fixBase + 0x0f) {
+            count = header & 0x0f;
+        } else {
+            headerLength = header == type16 ? 3 : 5;
+            if (length_ - position_ < headerLength) {
+                return DeserializeError::IncompleteInput;
+            }
+            count = load_big_endian(position_ + 1, headerLength - 1);
+        }
+        position_ += headerLength;
+        remaining_[depth_++] = static_cast<uint32_t>(count);
+        return DeserializeError::Ok;
+    }
+
+    // Counts down the entries of the innermost container; returns false after the last one
+    bool next_entry(bool& found) {
+        if (remaining_[depth_ - 1] == 0) {
+            --depth_;
+            found = false;
+            return false;
+        }
+        --remaining_[depth_ - 1];
+        found = true;
+        return true;
+    }
+
+    // Number that converts to T without a type or range error; nothing is consumed otherwise
+    template<typename T>
+    bool read_plain_number(T& value) {
+        size_t start = position_;
+        if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            int64_t raw = 0;
+            if (ReadInt(raw) == DeserializeError::Ok &&
+                raw >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
+                raw <= static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                value = static_cast<T>(raw);
+                return true;
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            uint64_t raw = 0;
+            if (ReadUInt(raw) == DeserializeError::Ok && raw <= static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                value = static_cast<T>(raw);
+                return true;
+            }
+        } else {
+            double raw = 0;
+            if (ReadDouble(raw) == DeserializeError::Ok &&
+                (raw != raw || (raw <= static_cast<double>(std::numeric_limits<T>::max()) &&
+                                raw >= -static_cast<double>(std::numeric_limits<T>::max())))) {
+                value = static_cast<T>(raw);
+                return true;
+            }
+        }
+        position_ = start;
+        return false;
+    }
+
+    // Decodes the integer at the current position without consuming it;
+    // negative values are returned as their two's complement bits
+    DeserializeError decode_integer(bool& isNegative, uint64_t& value, size_t& size) {
+        TokenType token = Peek();
+        if (token != TokenType::Number) {
+            return mismatch(token);
+        }
+        uint8_t type = byte_at(position_);
+        isNegative = false;
+        if (type <= 0x7f) {
+            value = type;
+            size = 1;
+            return DeserializeError::Ok;
+        }
+        if (type >= 0xe0) {
+            isNegative = true;
+            value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(type)));
+            size = 1;
+            return DeserializeError::Ok;
+        }
+        if (type == 0xca || type == 0xcb) {
+            return DeserializeError::TypeMismatch;
+        }
+        // 0xcc-0xcf: uint 8/16/32/64, 0xd0-0xd3: int 8/16/32/64
+        bool isSigned = type >= 0xd0;
+        size_t bytes = static_cast<size_t>(1) << (type - (isSigned ? 0xd0 : 0xcc));
+        if (length_ - position_ < 1 + bytes) {
+            return DeserializeError::IncompleteInput;
+        }
+        uint64_t raw = load_big_endian(position_ + 1, bytes);
+        if (isSigned) {
+            // Sign-extend
+            unsigned shift = static_cast<unsigned>(64 - 8 * bytes);
+            int64_t signedValue = static_cast<int64_t>(raw << shift) >> shift;
+            isNegative = signedValue < 0;
+            raw = static_cast<uint64_t>(signedValue);
+        }
+        value = raw;
+        size = 1 + bytes;
+        return DeserializeError::Ok;
+    }
+
+    const char* data_;
+    size_t length_;
+    size_t position_;
+    size_t depth_;
+    uint32_t remaining_[NAYAN_SERIALIZER_NESTING_LIMIT];
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATION_READER_H
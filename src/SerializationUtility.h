@@ -6,9 +6,12 @@
 #include <string>
 #include <sstream>
 #include <type_traits>
+#include <utility>
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <vector>
 #include <list>
 #include <deque>
@@ -18,6 +21,28 @@
 #include <unordered_map>
 #include <array>
 #include <forward_list>
+#include "NumericConversionUtility.h"
+#include "SerializationErrors.h"
+#include "SerializationContext.h"
+#include "SerializationWriter.h"
+#include "SerializationReader.h"
+#include "Base64.h"
+#include "OutputSink.h"
+#include "InputSource.h"
+#include "FieldMatchStats.h"
+
+// JSON inputs of at least this many bytes are read with a JsonStructuralIndex; 0 (the default)
+// never builds one. The reader's SIMD string scan already finds string ends about as fast as the
+// index does, so building the index is an extra pass that rarely pays for itself.
+#ifndef NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD
+#define NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD 0
+#endif
+
+// Unknown enum names: 0 reads them as the enum's first enumerator (as Deserialize always has),
+// 1 rejects them on every path (UnknownEnumValue, or an exception from the throwing API)
+#ifndef NAYAN_SERIALIZER_STRICT_ENUMS
+#define NAYAN_SERIALIZER_STRICT_ENUMS 0
+#endif
 
 namespace nayan {
 namespace serializer {
@@ -63,6 +88,11 @@ public:
         } else if constexpr (is_primitive_type_v<T>) {
             // Convert primitive type to string
             return convert_primitive_to_string(value);
+        } else if constexpr (is_base64_bytes_v<T>) {
+            // Opted-in byte buffer: a JSON string of base64
+            StdString output;
+            Serialize(value, output);
+            return output;
         } else if constexpr (is_sequential_container_v<T>) {
             // Handle sequential containers (vector, list, deque, set, unordered_set, etc.)
             return serialize_sequential_container(value);
@@ -83,6 +113,160 @@ public:
         }
     }
 
+    /**
+     * Serialize a value by appending it to an existing string.
+     * The string is not cleared, so several values can be written into the same buffer
+     * and its capacity is reused across calls.
+     * 
+     * @tparam T The type to serialize
+     * @param value The value to serialize
+     * @param output String to append the serialized value to
+     * @param context Supplies the allocator for the intermediate document
+     */
+    template<typename T>
+    static void Serialize(const T& value, StdString& output, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_optional_type_v<T>) {
+            // Empty optionals append nothing (same as the empty string returned by Serialize)
+            if (value.has_value()) {
+                Serialize(value.value(), output, context);
+            }
+        } else if constexpr (is_primitive_type_v<T>) {
+            append_primitive(value, output);
+        } else if constexpr (is_base64_bytes_v<T> || is_sequential_container_v<T> || is_associative_container_v<T> || has_write_to<T>::value) {
+            // Written straight into the output, no intermediate document. There is no reserve:
+            // MeasureSerialized is a second full pass over the value and costs more than the
+            // string's geometric growth; callers reusing `output` keep its capacity anyway.
+            JsonWriter<StdString> writer(output);
+            Write(writer, value);
+        } else if constexpr (std::is_enum_v<T>) {
+            // Enum names come from the S8_handle_enum_serialization.py specialization
+            output += Serialize(value);
+        } else if constexpr (has_serialize_to<T>::value) {
+            // Serializable object: build the tree in place and write it straight into the output
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            value.SerializeTo(doc.to<JsonObject>());
+            append_document(doc, output);
+        } else {
+            output += value.Serialize();
+        }
+    }
+
+    /**
+     * Serialize a value into a caller-provided buffer.
+     * The output is null-terminated; nothing is allocated for primitives.
+     * 
+     * @tparam T The type to serialize
+     * @param value The value to serialize
+     * @param buffer Output buffer
+     * @param capacity Size of the output buffer, including room for the null terminator
+     * @param context Supplies the allocator for the intermediate document
+     * @return Number of characters written (excluding the null terminator), or 0 if the output does not fit
+     */
+    template<typename T>
+    static size_t Serialize(const T& value, char* buffer, size_t capacity, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_optional_type_v<T>) {
+            if (value.has_value()) {
+                return Serialize(value.value(), buffer, capacity, context);
+            }
+            return write_text("", 0, buffer, capacity);
+        } else if constexpr (is_primitive_type_v<T>) {
+            return write_primitive(value, buffer, capacity);
+        } else if constexpr (is_base64_bytes_v<T> || is_sequential_container_v<T> || is_associative_container_v<T> || has_write_to<T>::value) {
+            if (capacity == 0) {
+                return 0;
+            }
+            // Keep one byte for the terminator; a partial result is discarded
+            FixedBufferOutput bufferOutput(buffer, capacity - 1);
+            JsonWriter<FixedBufferOutput> writer(bufferOutput);
+            Write(writer, value);
+            if (bufferOutput.overflow) {
+                buffer[0] = '\0';
+                return 0;
+            }
+            buffer[bufferOutput.size] = '\0';
+            return bufferOutput.size;
+        } else if constexpr (std::is_enum_v<T>) {
+            StdString name = Serialize(value);
+            return write_text(name.data(), name.size(), buffer, capacity);
+        } else if constexpr (has_serialize_to<T>::value) {
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            value.SerializeTo(doc.to<JsonObject>());
+            return write_document(doc, buffer, capacity);
+        } else {
+            StdString text = value.Serialize();
+            return write_text(text.data(), text.size(), buffer, capacity);
+        }
+    }
+
+    /**
+     * Serialize a value into a Sink (OstreamSink, FdSink, CallbackSink, ...; see OutputSink.h).
+     * Containers and serializable objects are streamed through a bounded SinkOutput buffer, so
+     * a collection of millions of objects never exists as one string or document.
+     *
+     * @tparam T The type to serialize
+     * @tparam Sink A type implementing the Sink concept
+     * @param value The value to serialize
+     * @param sink Destination of the JSON text
+     * @param context Supplies the allocator for the intermediate document (types without WriteTo)
+     * @return false if the sink reported a failure
+     */
+    template<typename T, typename Sink, typename = std::enable_if_t<is_output_sink<Sink>::value>>
+    static bool Serialize(const T& value, Sink& sink, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_optional_type_v<T>) {
+            // Empty optionals write nothing (same as the empty string returned by Serialize)
+            return value.has_value() ? Serialize(value.value(), sink, context) : true;
+        } else if constexpr (is_base64_bytes_v<T> || is_sequential_container_v<T> || is_associative_container_v<T> || has_write_to<T>::value) {
+            // Elements are written one after the other; only the buffer is held in memory
+            SinkOutput<Sink> output(sink);
+            JsonWriter<SinkOutput<Sink>> writer(output);
+            Write(writer, value);
+            return output.Flush();
+        } else {
+            // Primitives, enums and objects without WriteTo are small or need their whole text first
+            StdString text;
+            Serialize(value, text, context);
+            return text.empty() || sink.Write(text.data(), text.size());
+        }
+    }
+
+    /**
+     * Measure the exact number of characters Serialize would produce, without producing output.
+     * Primitives are measured from their formatted length on the stack; containers and
+     * serializable objects are measured with a CountingWriter.
+     * 
+     * @tparam T The type to measure
+     * @param value The value to measure
+     * @param context Supplies the allocator for the intermediate document
+     * @return Length of the serialized text (excluding any null terminator)
+     */
+    template<typename T>
+    static size_t MeasureSerialized(const T& value, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_optional_type_v<T>) {
+            return value.has_value() ? MeasureSerialized(value.value(), context) : 0;
+        } else if constexpr (is_primitive_type_v<T>) {
+            return measure_primitive(value);
+        } else if constexpr (is_base64_bytes_v<T> || is_sequential_container_v<T> || is_associative_container_v<T> || has_write_to<T>::value) {
+            // Counted while writing, nothing is stored
+            CountingWriter writer;
+            Write(writer, value);
+            return writer.Count();
+        } else if constexpr (std::is_enum_v<T>) {
+            return Serialize(value).size();
+        } else if constexpr (has_serialized_size<T>::value) {
+            // Generated by S3_inject_serialization.py
+            return value.SerializedSize(context);
+        } else if constexpr (has_serialize_to<T>::value) {
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            value.SerializeTo(doc.to<JsonObject>());
+            return measureJson(doc);
+        } else {
+            return value.Serialize().size();
+        }
+    }
+
     /**
      * Deserialize a string to a value of the specified type.
      * 
@@ -92,6 +276,29 @@ public:
      */
     template<typename ReturnType>
     static remove_cvref_t<ReturnType> Deserialize(const StdString& input) {
+        if constexpr (std::is_enum_v<ReturnType>) {
+            // Handle enum types - template specialization should be provided by S8_handle_enum_serialization.py
+            // If no specialization exists, this will cause a compilation error
+            // We can't call ReturnType::Deserialize() because enums don't have that method
+            // The specialization must exist for enums to work
+            // Use a dependent static_assert that only fails when ReturnType is an enum
+            static_assert(std::is_enum_v<ReturnType> && false, "Enum deserialization specialization not found. Run S8_handle_enum_serialization.py for this enum.");
+            return ReturnType(); // This line will never be reached due to static_assert
+        } else {
+            return Deserialize<ReturnType>(input, SerializationContext::Default());
+        }
+    }
+
+    /**
+     * Deserialize a string to a value of the specified type, taking document storage from a context.
+     * 
+     * @tparam ReturnType The type to deserialize to
+     * @param input The string input to deserialize
+     * @param context Supplies the allocator for the parsed document
+     * @return The deserialized value of type ReturnType
+     */
+    template<typename ReturnType>
+    static remove_cvref_t<ReturnType> Deserialize(const StdString& input, const SerializationContext& context) {
         if constexpr (is_optional_type_v<ReturnType>) {
             // Handle optional types (optional<T> or std::optional<T>)
             using ValueType = typename ReturnType::value_type;
@@ -101,67 +308,60 @@ public:
                 return ReturnType(); // Return empty optional
             }
             
-            // Try to parse as JSON to check if it's null
-            JsonDocument doc;
+            // Parse once and extract the value from the JSON tree
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
             DeserializationError error = deserializeJson(doc, input.c_str());
-            if (error == DeserializationError::Ok && doc.isNull()) {
-                return ReturnType(); // Return empty optional
-            }
-            
-            // If parsing succeeded, extract the value from JSON
-            ValueType value;
             if (error == DeserializationError::Ok) {
-                // For primitive types, extract directly from JSON
-                if constexpr (is_primitive_type_v<ValueType>) {
-                    if constexpr (std::is_same_v<ValueType, StdString> || std::is_same_v<ValueType, CStdString>) {
-                        // For strings, extract from JSON (handles quoted strings like "Hello World")
-                        if (doc.is<const char*>() || doc.is<StdString>()) {
-                            const char* str = doc.as<const char*>();
-                            if (str != nullptr) {
-                                value = StdString(str);
-                            } else {
-                                value = Deserialize<ValueType>(input);
-                            }
-                        } else {
-                            value = Deserialize<ValueType>(input);
-                        }
-                    } else {
-                        // For other primitives, use JSON extraction
-                        if (doc.is<ValueType>()) {
-                            value = doc.as<ValueType>();
-                        } else {
-                            value = Deserialize<ValueType>(input);
-                        }
-                    }
-                } else {
-                    // For complex types, serialize JSON back to string and deserialize
-                    StdString jsonStr;
-                    serializeJson(doc, jsonStr);
-                    value = Deserialize<ValueType>(jsonStr);
+                if (doc.isNull()) {
+                    return ReturnType(); // Return empty optional
                 }
-            } else {
-                // If JSON parsing failed, try direct deserialization
-                value = Deserialize<ValueType>(input);
+                return ReturnType(DeserializeFrom<ValueType>(doc.as<JsonVariantConst>()));
             }
             
-            return ReturnType(value);
+            // If JSON parsing failed, try direct deserialization (e.g. unquoted strings)
+            return ReturnType(Deserialize<ValueType>(input, context));
         } else if constexpr (is_primitive_type_v<ReturnType>) {
             // Convert string to primitive type
             return convert_string_to_primitive<remove_cvref_t<ReturnType>>(input);
+        } else if constexpr (is_base64_bytes_v<remove_cvref_t<ReturnType>>) {
+            using ValueType = remove_cvref_t<ReturnType>;
+            ValueType value{};
+            DeserializeStatus status = read_json(input.data(), input.size(), value);
+            if (!status) {
+                throw_status("Byte buffer error: ", status);
+            }
+            return value;
         } else if constexpr (is_sequential_container_v<ReturnType>) {
             // Handle sequential containers (vector, list, deque, set, unordered_set, etc.)
-            return deserialize_sequential_container<ReturnType>(input);
+            return deserialize_sequential_container<ReturnType>(input, context);
         } else if constexpr (is_associative_container_v<ReturnType>) {
             // Handle associative containers (StdMap, StdUnorderedMap)
-            return deserialize_associative_container<ReturnType>(input);
+            return deserialize_associative_container<ReturnType>(input, context);
         } else if constexpr (std::is_enum_v<ReturnType>) {
-            // Handle enum types - template specialization should be provided by S8_handle_enum_serialization.py
-            // If no specialization exists, this will cause a compilation error
-            // We can't call ReturnType::Deserialize() because enums don't have that method
-            // The specialization must exist for enums to work
-            // Use a dependent static_assert that only fails when ReturnType is an enum
-            static_assert(std::is_enum_v<ReturnType> && false, "Enum deserialization specialization not found. Run S8_handle_enum_serialization.py for this enum.");
-            return ReturnType(); // This line will never be reached due to static_assert
+            // Enum names are short: the S8_handle_enum_serialization.py specialization parses them directly
+            return Deserialize<ReturnType>(input);
+        } else if constexpr (has_read_from<remove_cvref_t<ReturnType>>::value) {
+            // Serializable object: the generated ReadFrom fills it while parsing, no document
+            using ValueType = remove_cvref_t<ReturnType>;
+            ValueType value;
+            DeserializeStatus status = read_json(input.data(), input.size(), value);
+            if (!status) {
+                throw_status(status.error == DeserializeError::ValidationFailed ? "Validation error: " : "JSON parse error: ", status);
+            }
+            return value;
+        } else if constexpr (has_from_json<remove_cvref_t<ReturnType>>::value) {
+            // Serializable object: parse into the context's document and build it from the tree
+            using ValueType = remove_cvref_t<ReturnType>;
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializationError error = deserializeJson(doc, input.c_str());
+            if (error) {
+                StdString errorMsg = "JSON parse error: ";
+                errorMsg += error.c_str();
+                NAYAN_SERIALIZER_THROW(std::runtime_error(errorMsg.c_str()));
+            }
+            return ValueType::FromJson(doc.as<JsonVariantConst>());
         } else {
             // Call the type's Deserialize method (use value type for reference types like const T&)
             using ValueType = remove_cvref_t<ReturnType>;
@@ -169,292 +369,2000 @@ public:
         }
     }
 
-    // Make is_primitive_type accessible to helper functions
-    template<typename T>
-    struct is_primitive_type {
-        static constexpr bool value = 
-            std::is_same_v<T, int> || std::is_same_v<T, unsigned int> ||
-            std::is_same_v<T, long> || std::is_same_v<T, unsigned long> ||
-            std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
-            std::is_same_v<T, char> || std::is_same_v<T, unsigned char> ||
-            std::is_same_v<T, bool> || std::is_same_v<T, float> ||
-            std::is_same_v<T, double> || std::is_same_v<T, size_t> ||
-            // StandardDefines types
-            std::is_same_v<T, Int> || std::is_same_v<T, CInt> ||
-            std::is_same_v<T, UInt> || std::is_same_v<T, CUInt> ||
-            std::is_same_v<T, Long> || std::is_same_v<T, CLong> ||
-            std::is_same_v<T, ULong> || std::is_same_v<T, CULong> ||
-            std::is_same_v<T, UInt8> ||
-            std::is_same_v<T, Char> || std::is_same_v<T, CChar> ||
-            std::is_same_v<T, UChar> || std::is_same_v<T, CUChar> ||
-            std::is_same_v<T, Bool> || std::is_same_v<T, CBool> ||
-            std::is_same_v<T, Size> || std::is_same_v<T, CSize> ||
-            std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>;
-    };
-    
-    // Helper variable template
-    template<typename T>
-    static constexpr bool is_primitive_type_v = is_primitive_type<T>::value;
-    
     /**
-     * Type trait to check if a type is a sequential container.
-     * Includes: vector, list, deque, set, unordered_set, array, forward_list
+     * Deserialize a value of the specified type from an already parsed JSON value.
+     * Containers and nested values are read directly from the JSON tree,
+     * so a payload is parsed exactly once regardless of nesting depth.
+     * 
+     * @tparam ReturnType The type to deserialize to
+     * @param input The JSON value to read from
+     * @return The deserialized value of type ReturnType
      */
-    template<typename T>
-    struct is_sequential_container {
-        static constexpr bool value = false;
-    };
-    
-    template<typename T, typename Alloc>
-    struct is_sequential_container<std::vector<T, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, typename Alloc>
-    struct is_sequential_container<std::list<T, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, typename Alloc>
-    struct is_sequential_container<std::deque<T, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, typename Compare, typename Alloc>
-    struct is_sequential_container<std::set<T, Compare, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, typename Hash, typename Equal, typename Alloc>
-    struct is_sequential_container<std::unordered_set<T, Hash, Equal, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, std::size_t N>
-    struct is_sequential_container<std::array<T, N>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename T, typename Alloc>
-    struct is_sequential_container<std::forward_list<T, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    // Note: StandardDefines template aliases (StdVector, StdList, etc.)
-    // all resolve to std:: types, so they are handled by the std:: specializations above.
-    // No additional specializations are needed since template aliases don't create new types.
-    
-    
-    // Helper variable template
-    template<typename T>
-    static constexpr bool is_sequential_container_v = is_sequential_container<T>::value;
-    
+    template<typename ReturnType>
+    static remove_cvref_t<ReturnType> DeserializeFrom(JsonVariantConst input) {
+        using ValueType = remove_cvref_t<ReturnType>;
+        if constexpr (is_optional_type_v<ValueType>) {
+            // JSON null maps to an empty optional
+            if (input.isNull()) {
+                return ValueType();
+            }
+            return ValueType(DeserializeFrom<typename ValueType::value_type>(input));
+        } else if constexpr (is_primitive_type_v<ValueType>) {
+            return read_primitive_from_variant<ValueType>(input);
+        } else if constexpr (is_base64_bytes_v<ValueType>) {
+            ValueType value{};
+            DeserializeStatus status = TryDeserializeFrom(input, value);
+            if (!status) {
+                throw_status("Byte buffer error: ", status);
+            }
+            return value;
+        } else if constexpr (is_sequential_container_v<ValueType>) {
+            return deserialize_sequential_container_from<ValueType>(input);
+        } else if constexpr (is_associative_container_v<ValueType>) {
+            return deserialize_associative_container_from<ValueType>(input);
+        } else if constexpr (std::is_enum_v<ValueType>) {
+            // The plain name, e.g. "Off"; anything but a string is a type error, unknown names
+            // follow NAYAN_SERIALIZER_STRICT_ENUMS like every other path
+            ValueType value{};
+            DeserializeStatus status = TryDeserializeFrom(input, value);
+            if (!status) {
+                throw_status("Enum value error: ", status);
+            }
+            return value;
+        } else if constexpr (has_from_json<ValueType>::value) {
+            // Serializable object: build it straight from the tree
+            return ValueType::FromJson(input);
+        } else {
+            // Serializable object without FromJson: hand its JSON text to the type's Deserialize method
+            StdString elementJson;
+            serializeJson(input, elementJson);
+            return ValueType::Deserialize(elementJson);
+        }
+    }
+
     /**
-     * Type trait to check if a type is an associative container (map).
-     * Includes: map, unordered_map, multimap, unordered_multimap
+     * Deserialize a string without throwing.
+     * On failure `out` is left unchanged and the returned status carries the error code,
+     * the innermost failing field (for serializable objects) and the byte offset of the error.
+     * 
+     * @tparam T The type to deserialize to
+     * @param input The string input to deserialize
+     * @param out Receives the deserialized value on success
+     * @param context Supplies the allocator for the parsed document
+     * @return DeserializeStatus describing the outcome
      */
     template<typename T>
-    struct is_associative_container {
-        static constexpr bool value = false;
-    };
-    
-    template<typename Key, typename Value, typename Compare, typename Alloc>
-    struct is_associative_container<std::map<Key, Value, Compare, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
-    struct is_associative_container<std::unordered_map<Key, Value, Hash, Equal, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename Key, typename Value, typename Compare, typename Alloc>
-    struct is_associative_container<std::multimap<Key, Value, Compare, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
-    struct is_associative_container<std::unordered_multimap<Key, Value, Hash, Equal, Alloc>> {
-        static constexpr bool value = true;
-    };
-    
-    // Handle StandardDefines aliases (StdMap, StdUnorderedMap)
-    template<typename Key, typename Value>
-    struct is_associative_container<StdMap<Key, Value>> {
-        static constexpr bool value = true;
-    };
-    
-    template<typename Key, typename Value>
-    struct is_associative_container<StdUnorderedMap<Key, Value>> {
-        static constexpr bool value = true;
-    };
-    
-    // Helper variable template
-    template<typename T>
-    static constexpr bool is_associative_container_v = is_associative_container<T>::value;
-    
+    static DeserializeStatus TryDeserialize(const StdString& input, T& out, const SerializationContext& context = SerializationContext::Default()) {
+        return TryDeserialize(input.data(), input.size(), out, context);
+    }
+
     /**
-     * Type trait to check if a type is an optional type (std::optional<T> or optional<T>).
+     * Deserialize a character range without throwing.
+     * 
+     * @tparam T The type to deserialize to
+     * @param input Start of the input (does not need to be null-terminated)
+     * @param length Number of characters in the input
+     * @param out Receives the deserialized value on success
+     * @param context Supplies the allocator for the parsed document
+     * @return DeserializeStatus describing the outcome
      */
     template<typename T>
-    struct is_optional_type {
-        static constexpr bool value = false;
-    };
-    
-    template<typename T>
-    struct is_optional_type<std::optional<T>> {
-        static constexpr bool value = true;
-    };
-    
-    // Helper variable template
-    template<typename T>
-    static constexpr bool is_optional_type_v = is_optional_type<T>::value;
+    static DeserializeStatus TryDeserialize(const char* input, size_t length, T& out, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_optional_type_v<T>) {
+            using ValueType = typename T::value_type;
+            
+            // Null or empty input maps to an empty optional
+            if (length == 0 || text_equals(input, length, "null") || text_equals(input, length, "{}")) {
+                out.reset();
+                return DeserializeStatus::Success();
+            }
+            
+            ValueType value{};
+            DeserializeStatus status;
+            if constexpr (is_primitive_type_v<ValueType>) {
+                // Accept both JSON values ("\"text\"", "12") and raw text (unquoted strings)
+                DocumentLease lease = context.AcquireDocument();
+                JsonDocument& doc = lease.Document();
+                if (parse_json(doc, input, length).ok()) {
+                    if (doc.isNull()) {
+                        out.reset();
+                        return DeserializeStatus::Success();
+                    }
+                    status = TryDeserializeFrom(doc.as<JsonVariantConst>(), value);
+                } else {
+                    status = TryDeserialize(input, length, value, context);
+                }
+            } else {
+                status = TryDeserialize(input, length, value, context);
+            }
+            if (status) {
+                out = std::move(value);
+            }
+            return status;
+        } else if constexpr (is_primitive_type_v<T>) {
+            // Primitives are read from their text form, like Deserialize
+            return to_status(try_convert_text_to_primitive(input, input + length, out));
+        } else if constexpr (std::is_enum_v<T>) {
+            // Enum names may be quoted ("Off") or bare (Off)
+            const char* first = input;
+            const char* last = input + length;
+            while (first < last && std::isspace(static_cast<unsigned char>(*first))) {
+                ++first;
+            }
+            while (last > first && std::isspace(static_cast<unsigned char>(*(last - 1)))) {
+                --last;
+            }
+            if (last - first >= 2 && *first == '"' && *(last - 1) == '"') {
+                ++first;
+                --last;
+            }
+            if (!ParseEnumName(first, static_cast<size_t>(last - first), out)) {
+                return DeserializeStatus::Failure(DeserializeError::UnknownEnumValue);
+            }
+            return DeserializeStatus::Success();
+        } else if constexpr (is_readable<T>()) {
+            // Containers and serializable objects: a single pull-parsing pass, no document
+            return read_json(input, length, out);
+        } else {
+            // Types without ReadFrom: parse once, then read from the tree
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializeStatus status = parse_json(doc, input, length);
+            if (!status) {
+                return status;
+            }
+            return TryDeserializeFrom(doc.as<JsonVariantConst>(), out);
+        }
+    }
+
+    /**
+     * Deserialize a value from an already parsed JSON value without throwing.
+     * Containers are built into a temporary, so `out` is only modified on success.
+     * 
+     * @tparam T The type to deserialize to
+     * @param input The JSON value to read from
+     * @param out Receives the deserialized value on success
+     * @return DeserializeStatus describing the outcome
+     */
+    template<typename T>
+    static DeserializeStatus TryDeserializeFrom(JsonVariantConst input, T& out) {
+        if constexpr (is_optional_type_v<T>) {
+            // JSON null maps to an empty optional
+            if (input.isNull()) {
+                out.reset();
+                return DeserializeStatus::Success();
+            }
+            typename T::value_type value{};
+            DeserializeStatus status = TryDeserializeFrom(input, value);
+            if (status) {
+                out = std::move(value);
+            }
+            return status;
+        } else if constexpr (is_primitive_type_v<T>) {
+            return to_status(try_read_primitive_from_variant(input, out));
+        } else if constexpr (is_base64_bytes_v<T>) {
+            const char* str = input.as<const char*>();
+            if (str == nullptr) {
+                return DeserializeStatus::Failure(DeserializeError::TypeMismatch);
+            }
+            return to_status(decode_base64(str, std::strlen(str), out));
+        } else if constexpr (is_sequential_container_v<T>) {
+            return try_deserialize_sequential_container_from(input, out);
+        } else if constexpr (is_associative_container_v<T>) {
+            return try_deserialize_associative_container_from(input, out);
+        } else if constexpr (std::is_enum_v<T>) {
+            const char* str = input.as<const char*>();
+            if (str == nullptr) {
+                return DeserializeStatus::Failure(DeserializeError::TypeMismatch);
+            }
+            if (!ParseEnumName(str, std::strlen(str), out)) {
+                return DeserializeStatus::Failure(DeserializeError::UnknownEnumValue);
+            }
+            return DeserializeStatus::Success();
+        } else {
+            // Serializable object: generated TryFromJson reports the failing field
+            static_assert(has_try_from_json<T>::value, "TryFromJson not found. Re-run S3_inject_serialization.py for this class.");
+            return T::TryFromJson(input, out);
+        }
+    }
+
+    /**
+     * Write a value through a Writer (JsonWriter, CountingWriter, MsgPackWriter, ...).
+     * Serializable objects use their generated WriteTo, so no document is built.
+     * Empty optionals are written as null, both as values and as fields of a generated WriteTo
+     * (the same output as SerializeInto/SerializeTo).
+     * 
+     * @tparam Writer A type implementing the Writer concept (see SerializationWriter.h)
+     * @tparam T The type to write
+     * @param writer The output backend
+     * @param value The value to write
+     */
+    template<typename Writer, typename T>
+    static void Write(Writer& writer, const T& value) {
+        if constexpr (is_optional_type_v<T>) {
+            if (value.has_value()) {
+                Write(writer, value.value());
+            } else {
+                writer.WriteNull();
+            }
+        } else if constexpr (is_primitive_type_v<T>) {
+            write_primitive_to(writer, value);
+        } else if constexpr (is_base64_bytes_v<T>) {
+            StdString text = encode_base64(value);
+            writer.WriteString(text.data(), text.size());
+        } else if constexpr (is_numeric_array_v<T>) {
+            // Contiguous numbers: formatted in one loop by the writer
+            writer.WriteNumbers(value.data(), value.size());
+        } else if constexpr (is_sequential_container_v<T>) {
+            // Writers that need the element count up front (MsgPackWriter) get it; forward_list has no size()
+            if constexpr (is_forward_list_v<T>) {
+                writer.BeginArray();
+            } else {
+                writer.BeginArray(value.size());
+            }
+            if constexpr (std::is_same_v<T, std::vector<bool>>) {
+                // vector<bool> elements are proxies
+                for (size_t i = 0; i < value.size(); ++i) {
+                    writer.WriteBool(static_cast<bool>(value[i]));
+                }
+            } else {
+                for (const auto& element : value) {
+                    Write(writer, element);
+                }
+            }
+            writer.EndArray();
+        } else if constexpr (is_associative_container_v<T>) {
+            writer.BeginObject(value.size());
+            for (const auto& pair : value) {
+                if constexpr (std::is_same_v<typename T::key_type, StdString> ||
+                              std::is_same_v<typename T::key_type, CStdString> ||
+                              std::is_same_v<typename T::key_type, std::string>) {
+                    writer.Key(pair.first.data(), pair.first.size());
+                } else {
+                    // Same key text as serialize_associative_container_into
+                    StdString keyStr = Serialize(pair.first);
+                    writer.Key(keyStr.data(), keyStr.size());
+                }
+                Write(writer, pair.second);
+            }
+            writer.EndObject();
+        } else if constexpr (std::is_enum_v<T>) {
+            // Enum specialization (S8_handle_enum_serialization.py) returns the plain name, e.g. "Off"
+            StdString enumStr = Serialize(value);
+            writer.WriteString(enumStr.data(), enumStr.size());
+        } else if constexpr (has_write_to<T>::value) {
+            // Generated by S3_inject_serialization.py
+            value.WriteTo(writer);
+        } else {
+            // Serializable object without WriteTo: replay its tree
+            DocumentLease lease = SerializationContext::Default().AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            SerializeInto(value, doc.to<JsonVariant>());
+            write_variant(writer, doc.as<JsonVariantConst>());
+        }
+    }
+
+    /**
+     * Read a value through a Reader (JsonReader, MsgPackReader, ...) without building a document.
+     * Follows the rules of TryDeserializeFrom: null keeps empty/default values, numbers and booleans
+     * sent as strings are converted, and `out` is only modified on success.
+     * Serializable objects use their generated ReadFrom.
+     * 
+     * @tparam Reader A type implementing the Reader concept (see SerializationReader.h)
+     * @tparam T The type to read
+     * @param reader The input backend, positioned at the value
+     * @param out Receives the value on success
+     * @return DeserializeStatus describing the outcome (offset = reader position)
+     */
+    template<typename Reader, typename T>
+    static DeserializeStatus Read(Reader& reader, T& out) {
+        if constexpr (is_optional_type_v<T>) {
+            if (reader.Peek() == TokenType::Null) {
+                DeserializeError error = reader.ReadNull();
+                if (error != DeserializeError::Ok) {
+                    return read_failure(reader, error);
+                }
+                out.reset();
+                return DeserializeStatus::Success();
+            }
+            typename T::value_type value{};
+            DeserializeStatus status = Read(reader, value);
+            if (status) {
+                out = std::move(value);
+            }
+            return status;
+        } else if constexpr (is_primitive_type_v<T>) {
+            size_t start = value_start(reader);
+            DeserializeError error = read_primitive_from(reader, out);
+            return error == DeserializeError::Ok ? DeserializeStatus::Success() : value_failure(reader, start, error);
+        } else if constexpr (is_base64_bytes_v<T>) {
+            size_t start = value_start(reader);
+            const char* text = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadString(text, length);
+            if (error == DeserializeError::Ok) {
+                error = decode_base64(text, length, out);
+            }
+            return error == DeserializeError::Ok ? DeserializeStatus::Success() : value_failure(reader, start, error);
+        } else if constexpr (is_sequential_container_v<T>) {
+            return read_sequential_container(reader, out);
+        } else if constexpr (is_associative_container_v<T>) {
+            return read_associative_container(reader, out);
+        } else if constexpr (std::is_enum_v<T>) {
+            size_t start = value_start(reader);
+            const char* text = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadString(text, length);
+            if (error != DeserializeError::Ok) {
+                return value_failure(reader, start, error);
+            }
+            if (!ParseEnumName(text, length, out)) {
+                return value_failure(reader, start, DeserializeError::UnknownEnumValue);
+            }
+            return DeserializeStatus::Success();
+        } else {
+            static_assert(has_read_from<T>::value, "ReadFrom not found. Re-run S3_inject_serialization.py for this class.");
+            return T::ReadFrom(reader, out);
+        }
+    }
+
+    /**
+     * Serialize a value to MessagePack, appending to an existing string.
+     * The value is written through a MsgPackWriter, so every type supported for JSON is supported here.
+     * 
+     * @tparam T The type to serialize
+     * @param value The value to serialize
+     * @param output String to append the MessagePack bytes to
+     * @param context Supplies the allocator for the intermediate document (objects without WriteTo)
+     */
+    template<typename T>
+    static void SerializeMsgPack(const T& value, StdString& output, const SerializationContext& context = SerializationContext::Default()) {
+        MsgPackWriter writer(output);
+        if constexpr (!has_write_to<T>::value && has_serialize_to<T>::value) {
+            // Serializable object without WriteTo: build the tree in the context's document and replay it
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            value.SerializeTo(doc.to<JsonObject>());
+            write_variant(writer, doc.as<JsonVariantConst>());
+        } else {
+            // Written straight into the output, no intermediate document
+            (void)context;
+            Write(writer, value);
+        }
+    }
+
+    /**
+     * Serialize a value to MessagePack.
+     * 
+     * @tparam T The type to serialize
+     * @param value The value to serialize
+     * @param context Supplies the allocator for the intermediate document
+     * @return The MessagePack bytes
+     */
+    template<typename T>
+    static StdString SerializeMsgPack(const T& value, const SerializationContext& context = SerializationContext::Default()) {
+        StdString output;
+        SerializeMsgPack(value, output, context);
+        return output;
+    }
+
+    /**
+     * Deserialize a value from MessagePack.
+     * Serializable objects are read by their generated ReadFrom, which validates them as for JSON input.
+     * 
+     * @tparam ReturnType The type to deserialize to
+     * @param input Start of the MessagePack bytes
+     * @param length Number of bytes
+     * @param context Supplies the allocator for the parsed document
+     * @return The deserialized value of type ReturnType
+     */
+    template<typename ReturnType>
+    static remove_cvref_t<ReturnType> DeserializeMsgPack(const char* input, size_t length, const SerializationContext& context = SerializationContext::Default()) {
+        using ValueType = remove_cvref_t<ReturnType>;
+        if constexpr (has_read_from<ValueType>::value) {
+            ValueType value;
+            MsgPackReader reader(input, length);
+            DeserializeStatus status = read_value(reader, value);
+            if (!status) {
+                throw_status(status.error == DeserializeError::ValidationFailed ? "Validation error: " : "MessagePack parse error: ", status);
+            }
+            return value;
+        } else {
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializationError error = deserializeMsgPack(doc, input, length);
+            if (error) {
+                StdString errorMsg = "MessagePack parse error: ";
+                errorMsg += error.c_str();
+                NAYAN_SERIALIZER_THROW(std::runtime_error(errorMsg.c_str()));
+            }
+            return DeserializeFrom<ReturnType>(doc.as<JsonVariantConst>());
+        }
+    }
+
+    template<typename ReturnType>
+    static remove_cvref_t<ReturnType> DeserializeMsgPack(const StdString& input, const SerializationContext& context = SerializationContext::Default()) {
+        return DeserializeMsgPack<ReturnType>(input.data(), input.size(), context);
+    }
+
+    /**
+     * Deserialize a value from MessagePack without throwing (see TryDeserialize).
+     * 
+     * @tparam T The type to deserialize to
+     * @param input Start of the MessagePack bytes
+     * @param length Number of bytes
+     * @param out Receives the deserialized value on success
+     * @param context Supplies the allocator for the parsed document
+     * @return DeserializeStatus describing the outcome
+     */
+    template<typename T>
+    static DeserializeStatus TryDeserializeMsgPack(const char* input, size_t length, T& out, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_readable<T>()) {
+            (void)context;
+            MsgPackReader reader(input, length);
+            return read_value(reader, out);
+        } else {
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializeStatus status = parse_msgpack(doc, input, length);
+            if (!status) {
+                return status;
+            }
+            return TryDeserializeFrom(doc.as<JsonVariantConst>(), out);
+        }
+    }
+
+    template<typename T>
+    static DeserializeStatus TryDeserializeMsgPack(const StdString& input, T& out, const SerializationContext& context = SerializationContext::Default()) {
+        return TryDeserializeMsgPack(input.data(), input.size(), out, context);
+    }
+
+    /**
+     * Deserialize a top-level JSON array one element at a time from a Source (IstreamSource,
+     * FdSource, MemorySource, ...; see InputSource.h) and pass each element to `callback`.
+     * Only the current element is buffered, so memory use is bounded by the largest element,
+     * not by the input. Elements are validated like TryDeserialize (generated ReadFrom).
+     *
+     * The callback receives a T& it may move from. If it returns bool, false stops the iteration
+     * (the rest of the input is not read).
+     *
+     * @tparam T The element type
+     * @tparam Source A type implementing the Source concept
+     * @param source Input positioned at the array
+     * @param callback Called with every element in order
+     * @param context Supplies the allocator for element types without ReadFrom
+     * @return DeserializeStatus of the first failure (offset = position in the whole input), or success
+     */
+    template<typename T, typename Source, typename Callback>
+    static DeserializeStatus ForEachElement(Source& source, Callback&& callback, const SerializationContext& context = SerializationContext::Default()) {
+        static_assert(is_input_source<Source>::value, "ForEachElement needs a Source (see InputSource.h)");
+        SourceBuffer<Source> input(source);
+        if (!skip_source_whitespace(input)) {
+            return source_end_status(input, DeserializeError::EmptyInput);
+        }
+        if (input.Data()[0] != '[') {
+            return DeserializeStatus::Failure(DeserializeError::TypeMismatch, nullptr, input.Position());
+        }
+        input.Consume(1);
+
+        bool first = true;
+        while (true) {
+            if (!skip_source_whitespace(input)) {
+                return source_end_status(input, DeserializeError::IncompleteInput);
+            }
+            if (first && input.Data()[0] == ']') {
+                return DeserializeStatus::Success();
+            }
+            first = false;
+
+            // Buffer the whole element: everything up to the next ',' or ']' at its own level
+            ElementScan scan;
+            while (true) {
+                DeserializeError error = scan_element(input.Data(), input.Size(), scan);
+                if (error != DeserializeError::Ok) {
+                    return DeserializeStatus::Failure(error, nullptr, input.Position() + scan.position);
+                }
+                if (scan.found) {
+                    break;
+                }
+                if (!input.Fill()) {
+                    return source_end_status(input, DeserializeError::IncompleteInput);
+                }
+            }
+            size_t length = scan.position;
+            while (length > 0 && is_json_whitespace(input.Data()[length - 1])) {
+                --length;
+            }
+            if (length == 0) {
+                return DeserializeStatus::Failure(DeserializeError::InvalidInput, nullptr, input.Position() + scan.position);
+            }
+
+            T value{};
+            DeserializeStatus status = read_complete_value(input.Data(), length, value, context);
+            if (!status) {
+                status.offset += input.Position();
+                return status;
+            }
+            char separator = input.Data()[scan.position];
+            input.Consume(scan.position + 1);
+            if (!invoke_element_callback(callback, value) || separator == ']') {
+                return DeserializeStatus::Success();
+            }
+        }
+    }
+
+    /**
+     * Parse an enum value from its name (case-insensitive) without throwing.
+     * Specializations are generated by S8_handle_enum_serialization.py. Deserialization goes
+     * through ParseEnumName, which also decides what an unknown name means.
+     * 
+     * @tparam E The enum type
+     * @param text Start of the name (does not need to be null-terminated)
+     * @param length Length of the name
+     * @param out Receives the enum value on success
+     * @return true if the name matches a value of E
+     */
+    template<typename E>
+    static bool TryParseEnum(const char* text, size_t length, E& out) {
+        // Use a dependent static_assert that only fails when the primary template is instantiated
+        static_assert(std::is_enum_v<E> && false, "Enum parse specialization not found. Run S8_handle_enum_serialization.py for this enum.");
+        (void)text;
+        (void)length;
+        (void)out;
+        return false;
+    }
+
+    /**
+     * The first declared enumerator of E, used for unknown names unless NAYAN_SERIALIZER_STRICT_ENUMS is set.
+     * Specializations are generated by S8_handle_enum_serialization.py.
+     * 
+     * @return false if E declares no enumerators
+     */
+    template<typename E>
+    static bool DefaultEnumValue(E& out) {
+        static_assert(std::is_enum_v<E> && false, "Enum default specialization not found. Run S8_handle_enum_serialization.py for this enum.");
+        (void)out;
+        return false;
+    }
+
+    /**
+     * Parse an enum name the way every deserialization path does (ReadFrom, TryDeserialize,
+     * Deserialize, FromJson, MessagePack): known names case-insensitively, unknown names as the
+     * first enumerator, or as a failure when NAYAN_SERIALIZER_STRICT_ENUMS is 1.
+     */
+    template<typename E>
+    static bool ParseEnumName(const char* text, size_t length, E& out) {
+        if (TryParseEnum(text, length, out)) {
+            return true;
+        }
+#if NAYAN_SERIALIZER_STRICT_ENUMS
+        return false;
+#else
+        return DefaultEnumValue(out);
+#endif
+    }
+
+    /**
+     * Seeded 32-bit FNV-1a hash of a member key.
+     * Used by the generated FieldSlot perfect hash; S3_inject_serialization.py computes the same
+     * hash (field_name_hash) when it builds the displacement table, so the two must stay in sync.
+     */
+    static uint32_t FieldNameHash(uint32_t seed, const char* key, size_t length) {
+        uint32_t hash = seed ^ 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<unsigned char>(key[i]);
+            hash *= 16777619u;
+        }
+        // Fold the high bits in: the low bits of FNV alone barely depend on the seed
+        return hash ^ (hash >> 16);
+    }
+
+    /**
+     * Compare a character range with a null-terminated string, ignoring ASCII case.
+     * Used by the generated TryParseEnum specializations.
+     */
+    static bool text_equals_ignore_case(const char* text, size_t length, const char* expected) {
+        for (size_t i = 0; i < length; ++i) {
+            if (expected[i] == '\0' ||
+                std::tolower(static_cast<unsigned char>(text[i])) != std::tolower(static_cast<unsigned char>(expected[i]))) {
+                return false;
+            }
+        }
+        return expected[length] == '\0';
+    }
+
+    // Make is_primitive_type accessible to helper functions
+    template<typename T>
+    struct is_primitive_type {
+        static constexpr bool value = 
+            std::is_same_v<T, int> || std::is_same_v<T, unsigned int> ||
+            std::is_same_v<T, long> || std::is_same_v<T, unsigned long> ||
+            std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
+            std::is_same_v<T, char> || std::is_same_v<T, unsigned char> ||
+            std::is_same_v<T, bool> || std::is_same_v<T, float> ||
+            std::is_same_v<T, double> || std::is_same_v<T, size_t> ||
+            // StandardDefines types
+            std::is_same_v<T, Int> || std::is_same_v<T, CInt> ||
+            std::is_same_v<T, UInt> || std::is_same_v<T, CUInt> ||
+            std::is_same_v<T, Long> || std::is_same_v<T, CLong> ||
+            std::is_same_v<T, ULong> || std::is_same_v<T, CULong> ||
+            std::is_same_v<T, UInt8> ||
+            std::is_same_v<T, Char> || std::is_same_v<T, CChar> ||
+            std::is_same_v<T, UChar> || std::is_same_v<T, CUChar> ||
+            std::is_same_v<T, Bool> || std::is_same_v<T, CBool> ||
+            std::is_same_v<T, Size> || std::is_same_v<T, CSize> ||
+            std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>;
+    };
+    
+    // Helper variable template
+    template<typename T>
+    static constexpr bool is_primitive_type_v = is_primitive_type<T>::value;
+    
+    /**
+     * Type trait to check if a type is a sequential container.
+     * Includes: vector, list, deque, set, unordered_set, array, forward_list
+     */
+    template<typename T>
+    struct is_sequential_container {
+        static constexpr bool value = false;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_sequential_container<std::vector<T, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_sequential_container<std::list<T, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_sequential_container<std::deque<T, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, typename Compare, typename Alloc>
+    struct is_sequential_container<std::set<T, Compare, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, typename Hash, typename Equal, typename Alloc>
+    struct is_sequential_container<std::unordered_set<T, Hash, Equal, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, std::size_t N>
+    struct is_sequential_container<std::array<T, N>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_sequential_container<std::forward_list<T, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    // Note: StandardDefines template aliases (StdVector, StdList, etc.)
+    // all resolve to std:: types, so they are handled by the std:: specializations above.
+    // No additional specializations are needed since template aliases don't create new types.
+    
+    
+    // Helper variable template
+    template<typename T>
+    static constexpr bool is_sequential_container_v = is_sequential_container<T>::value;
+    
+    /**
+     * Type trait for forward_list, the one sequential container without size().
+     */
+    template<typename T>
+    struct is_forward_list {
+        static constexpr bool value = false;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_forward_list<std::forward_list<T, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename T>
+    static constexpr bool is_forward_list_v = is_forward_list<T>::value;
+    
+    /**
+     * Type trait for contiguous containers of numbers (vector/array of integer or floating point
+     * values; bool and char are excluded), which are written and read in one tight loop.
+     */
+    template<typename T>
+    struct is_numeric_array {
+        static constexpr bool value = false;
+    };
+    
+    template<typename T, typename Alloc>
+    struct is_numeric_array<std::vector<T, Alloc>> {
+        static constexpr bool value = is_primitive_type<T>::value && std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>;
+    };
+    
+    template<typename T, std::size_t N>
+    struct is_numeric_array<std::array<T, N>> {
+        static constexpr bool value = is_primitive_type<T>::value && std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>;
+    };
+    
+    template<typename T>
+    static constexpr bool is_numeric_array_v = is_numeric_array<T>::value;
+    
+    /**
+     * Byte buffers opted in to base64 strings (Base64Bytes, Base64Array or an is_base64_bytes
+     * specialization, see Base64.h). Checked before the container traits, so a specialized
+     * StdVector<UInt8> is written as a string rather than an array of numbers.
+     */
+    template<typename T>
+    static constexpr bool is_base64_bytes_v = is_base64_bytes<T>::value;
+    
+    /**
+     * Type trait to check if a byte buffer can be resized (otherwise its size is fixed, as for Base64Array).
+     */
+    template<typename T, typename = void>
+    struct has_resize : std::false_type {};
+    
+    template<typename T>
+    struct has_resize<T, std::void_t<decltype(std::declval<T&>().resize(std::size_t()))>> : std::true_type {};
+    
+    /**
+     * Type trait to check if a type is an associative container (map).
+     * Includes: map, unordered_map, multimap, unordered_multimap
+     */
+    template<typename T>
+    struct is_associative_container {
+        static constexpr bool value = false;
+    };
+    
+    template<typename Key, typename Value, typename Compare, typename Alloc>
+    struct is_associative_container<std::map<Key, Value, Compare, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+    struct is_associative_container<std::unordered_map<Key, Value, Hash, Equal, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename Key, typename Value, typename Compare, typename Alloc>
+    struct is_associative_container<std::multimap<Key, Value, Compare, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+    struct is_associative_container<std::unordered_multimap<Key, Value, Hash, Equal, Alloc>> {
+        static constexpr bool value = true;
+    };
+    
+    // Handle StandardDefines aliases (StdMap, StdUnorderedMap)
+    template<typename Key, typename Value>
+    struct is_associative_container<StdMap<Key, Value>> {
+        static constexpr bool value = true;
+    };
+    
+    template<typename Key, typename Value>
+    struct is_associative_container<StdUnorderedMap<Key, Value>> {
+        static constexpr bool value = true;
+    };
+    
+    // Helper variable template
+    template<typename T>
+    static constexpr bool is_associative_container_v = is_associative_container<T>::value;
+    
+    /**
+     * Type trait to check if a type is an optional type (std::optional<T> or optional<T>).
+     */
+    template<typename T>
+    struct is_optional_type {
+        static constexpr bool value = false;
+    };
+    
+    template<typename T>
+    struct is_optional_type<std::optional<T>> {
+        static constexpr bool value = true;
+    };
+    
+    // Helper variable template
+    template<typename T>
+    static constexpr bool is_optional_type_v = is_optional_type<T>::value;
+    
+    /**
+     * Type trait to check if a type provides SerializeTo(JsonObject) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_serialize_to : std::false_type {};
+    
+    template<typename T>
+    struct has_serialize_to<T, std::void_t<decltype(std::declval<const T&>().SerializeTo(std::declval<JsonObject>()))>>
+        : std::true_type {};
+    
+    /**
+     * Type trait to check if a type provides WriteTo(Writer&) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_write_to : std::false_type {};
+    
+    template<typename T>
+    struct has_write_to<T, std::void_t<decltype(std::declval<const T&>().WriteTo(std::declval<JsonWriter<StdString>&>()))>>
+        : std::true_type {};
+    
+    /**
+     * Type trait to check if a type provides static ReadFrom(Reader&, T&) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_read_from : std::false_type {};
+    
+    template<typename T>
+    struct has_read_from<T, std::void_t<decltype(T::ReadFrom(std::declval<JsonReader&>(), std::declval<T&>()))>>
+        : std::true_type {};
+    
+    /**
+     * Whether Read supports a type: primitives, enums, serializable objects with ReadFrom and
+     * optionals/containers of those. Other types are still deserialized through a document.
+     */
+    template<typename T>
+    static constexpr bool is_readable() {
+        if constexpr (is_optional_type_v<T>) {
+            return is_readable<typename T::value_type>();
+        } else if constexpr (is_primitive_type_v<T> || std::is_enum_v<T> || is_base64_bytes_v<T>) {
+            return true;
+        } else if constexpr (is_associative_container_v<T>) {
+            return is_readable<typename T::mapped_type>();
+        } else if constexpr (is_sequential_container_v<T>) {
+            return is_readable<typename T::value_type>();
+        } else {
+            return has_read_from<T>::value;
+        }
+    }
+    
+    /**
+     * Type trait to check if a type provides SerializedSize() (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_serialized_size : std::false_type {};
+    
+    template<typename T>
+    struct has_serialized_size<T, std::void_t<decltype(std::declval<const T&>().SerializedSize(std::declval<const SerializationContext&>()))>>
+        : std::true_type {};
+    
+    /**
+     * Type trait to check if a type provides static FromJson(JsonVariantConst) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_from_json : std::false_type {};
+    
+    template<typename T>
+    struct has_from_json<T, std::void_t<decltype(T::FromJson(std::declval<JsonVariantConst>()))>>
+        : std::true_type {};
+
+    /**
+     * Type trait to check if a type provides static TryFromJson(JsonVariantConst, T&) (generated by S3_inject_serialization.py).
+     */
+    template<typename T, typename = void>
+    struct has_try_from_json : std::false_type {};
+    
+    template<typename T>
+    struct has_try_from_json<T, std::void_t<decltype(T::TryFromJson(std::declval<JsonVariantConst>(), std::declval<T&>()))>>
+        : std::true_type {};
+    
+    /**
+     * Convert a primitive type to StdString.
+     * Uses overloads for special cases.
+     */
+    template<typename T>
+    static StdString convert_primitive_to_string(const T& value) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            return value ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, StdString>) {
+            return value;
+        } else if constexpr (std::is_same_v<T, CStdString>) {
+            return StdString(value);
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            // Character types are written as the character itself
+            return StdString(1, static_cast<char>(value));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            // Locale-independent, allocation-free formatting (shortest round-trip form for floating point)
+            char buffer[NumericConversionUtility::MaxFormattedLength];
+            size_t length = 0;
+            if (NumericConversionUtility::FormatNumber(value, buffer, sizeof(buffer), length) != NumericConversionStatus::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Cannot format numeric value"));
+            }
+            return StdString(buffer, length);
+        } else {
+            std::ostringstream oss;
+            oss << value;
+            return StdString(oss.str());
+        }
+    }
+    
+    /**
+     * Append a primitive value to a string (same text as convert_primitive_to_string, without a temporary).
+     */
+    template<typename T>
+    static void append_primitive(const T& value, StdString& output) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            output += value ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>) {
+            output += value;
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            output += static_cast<char>(value);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            if (NumericConversionUtility::AppendNumber(value, output) != NumericConversionStatus::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Cannot format numeric value"));
+            }
+        } else {
+            output += convert_primitive_to_string(value);
+        }
+    }
+
+    /**
+     * Write a primitive value into a caller-provided buffer (null-terminated).
+     * Returns the number of characters written, or 0 if the value does not fit.
+     */
+    template<typename T>
+    static size_t write_primitive(const T& value, char* buffer, size_t capacity) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            return value ? write_text("true", 4, buffer, capacity) : write_text("false", 5, buffer, capacity);
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>) {
+            return write_text(value.data(), value.size(), buffer, capacity);
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            char c = static_cast<char>(value);
+            return write_text(&c, 1, buffer, capacity);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            // Format straight into the caller's buffer, keeping one byte for the terminator
+            size_t length = 0;
+            if (capacity == 0 ||
+                NumericConversionUtility::FormatNumber(value, buffer, capacity - 1, length) != NumericConversionStatus::Ok) {
+                return write_text("", 0, buffer, capacity);
+            }
+            buffer[length] = '\0';
+            return length;
+        } else {
+            StdString text = convert_primitive_to_string(value);
+            return write_text(text.data(), text.size(), buffer, capacity);
+        }
+    }
+
+    /**
+     * Copy text into a caller-provided buffer (null-terminated).
+     * Returns the number of characters written, or 0 (empty buffer) if the text does not fit.
+     */
+    static size_t write_text(const char* text, size_t length, char* buffer, size_t capacity) {
+        if (capacity == 0) {
+            return 0;
+        }
+        if (length + 1 > capacity) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        std::memcpy(buffer, text, length);
+        buffer[length] = '\0';
+        return length;
+    }
+
+    /**
+     * Serialize a document into a caller-provided buffer (null-terminated).
+     * Returns the number of characters written, or 0 (empty buffer) if the JSON does not fit.
+     */
+    static size_t write_document(const JsonDocument& doc, char* buffer, size_t capacity) {
+        if (capacity == 0) {
+            return 0;
+        }
+        size_t written = serializeJson(doc, buffer, capacity);
+        // serializeJson truncates silently: a full buffer may hold only part of the output
+        if (written + 1 >= capacity && measureJson(doc) + 1 > capacity) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        return written;
+    }
+
+    /**
+     * Append a document to a string, growing the string once to the exact size.
+     */
+    static void append_document(const JsonDocument& doc, StdString& output) {
+        output.reserve(output.size() + measureJson(doc));
+        serializeJson(doc, output);
+    }
+
+    /**
+     * Length of the text convert_primitive_to_string would produce, formatted on the stack.
+     */
+    template<typename T>
+    static size_t measure_primitive(const T& value) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            return value ? 4 : 5;
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>) {
+            return value.size();
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            return 1;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            char buffer[NumericConversionUtility::MaxFormattedLength];
+            size_t length = 0;
+            NumericConversionUtility::FormatNumber(value, buffer, sizeof(buffer), length);
+            return length;
+        } else {
+            return convert_primitive_to_string(value).size();
+        }
+    }
+    
+    /**
+     * Convert a string to a primitive type.
+     * 
+     * @tparam T The primitive type to convert to
+     * @param input The string input
+     * @return The converted value of type T
+     */
+    template<typename T>
+    static T convert_string_to_primitive(const StdString& input) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            // Handle boolean: "true", "false", "1", "0"
+            StdString lower = input;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            if (lower == "true" || lower == "1") {
+                return true;
+            } else if (lower == "false" || lower == "0") {
+                return false;
+            } else {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Invalid boolean value: " + input_excerpt(input)));
+            }
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>) {
+            // Already a string, just return it
+            return input;
+        } else if constexpr (std::is_integral_v<T>) {
+            // Integer types
+            T value{};
+            if (NumericConversionUtility::ParseNumber(input.data(), input.data() + input.size(), value) != NumericConversionStatus::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Invalid integer value: " + input_excerpt(input)));
+            }
+            return value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // Floating point types
+            T value{};
+            if (NumericConversionUtility::ParseNumber(input.data(), input.data() + input.size(), value) != NumericConversionStatus::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Invalid floating point value: " + input_excerpt(input)));
+            }
+            return value;
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, Char> || std::is_same_v<T, CChar> ||
+                             std::is_same_v<T, unsigned char> || std::is_same_v<T, UChar> || std::is_same_v<T, CUChar> ||
+                             std::is_same_v<T, UInt8>) {
+            // Character types
+            if (input.length() == 1) {
+                return static_cast<T>(input[0]);
+            } else if (input.length() == 0) {
+                return static_cast<T>(0);
+            } else {
+                // Try to parse as integer for character types
+                int code = 0;
+                if (NumericConversionUtility::ParseNumber(input.data(), input.data() + input.size(), code) != NumericConversionStatus::Ok) {
+                    NAYAN_SERIALIZER_THROW(std::invalid_argument("Invalid character value: " + input_excerpt(input)));
+                }
+                return static_cast<T>(code);
+            }
+        } else {
+            // Fallback: try to use stringstream
+            std::istringstream iss(input);
+            T value;
+            if (!(iss >> value)) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Cannot convert string to type: " + input_excerpt(input)));
+            }
+            return value;
+        }
+    }
+    
+    /**
+     * Convert a character range to a primitive type without throwing.
+     * Mirrors convert_string_to_primitive; `out` is unchanged on failure.
+     */
+    template<typename T>
+    static DeserializeError try_convert_text_to_primitive(const char* first, const char* last, T& out) {
+        size_t length = static_cast<size_t>(last - first);
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            // Handle boolean: "true", "false", "1", "0"
+            if (text_equals_ignore_case(first, length, "true") || text_equals(first, length, "1")) {
+                out = true;
+            } else if (text_equals_ignore_case(first, length, "false") || text_equals(first, length, "0")) {
+                out = false;
+            } else {
+                return DeserializeError::InvalidInput;
+            }
+            return DeserializeError::Ok;
+        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString> || std::is_same_v<T, std::string>) {
+            out = T(first, length);
+            return DeserializeError::Ok;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            T value{};
+            NumericConversionStatus status = NumericConversionUtility::ParseNumber(first, last, value);
+            if (status == NumericConversionStatus::OutOfRange) {
+                return DeserializeError::OutOfRange;
+            }
+            if (status != NumericConversionStatus::Ok) {
+                return DeserializeError::InvalidInput;
+            }
+            out = value;
+            return DeserializeError::Ok;
+        } else {
+            // Fallback: try to use stringstream
+            std::istringstream iss(StdString(first, length));
+            T value;
+            if (!(iss >> value)) {
+                return DeserializeError::InvalidInput;
+            }
+            out = value;
+            return DeserializeError::Ok;
+        }
+    }
+
+    /**
+     * Compare a character range with a null-terminated string.
+     */
+    static bool text_equals(const char* text, size_t length, const char* expected) {
+        return std::strlen(expected) == length && std::memcmp(text, expected, length) == 0;
+    }
+
+    static DeserializeStatus to_status(DeserializeError error) {
+        return error == DeserializeError::Ok ? DeserializeStatus::Success() : DeserializeStatus::Failure(error);
+    }
+
+    /**
+     * Reader that tracks how many bytes ArduinoJson consumed, so parse errors carry an offset.
+     */
+    struct CountingReader {
+        const char* data;
+        size_t length;
+        size_t consumed;
+
+        int read() {
+            if (consumed >= length) {
+                return -1;
+            }
+            return static_cast<unsigned char>(data[consumed++]);
+        }
+
+        size_t readBytes(char* buffer, size_t count) {
+            size_t available = length - consumed;
+            size_t n = count < available ? count : available;
+            std::memcpy(buffer, data + consumed, n);
+            consumed += n;
+            return n;
+        }
+    };
+
+    /**
+     * Parse JSON text into a document, mapping ArduinoJson errors to DeserializeStatus.
+     */
+    static DeserializeStatus parse_json(JsonDocument& doc, const char* input, size_t length) {
+        CountingReader reader{input, length, 0};
+        DeserializationError error = deserializeJson(doc, reader);
+        return to_parse_status(error, reader);
+    }
+
+    /**
+     * Parse MessagePack into a document, mapping ArduinoJson errors to DeserializeStatus.
+     */
+    static DeserializeStatus parse_msgpack(JsonDocument& doc, const char* input, size_t length) {
+        CountingReader reader{input, length, 0};
+        DeserializationError error = deserializeMsgPack(doc, reader);
+        return to_parse_status(error, reader);
+    }
+
+    static DeserializeStatus to_parse_status(DeserializationError error, const CountingReader& reader) {
+        if (!error) {
+            return DeserializeStatus::Success();
+        }
+        // The offending byte is the last one the parser consumed
+        size_t offset = reader.consumed > 0 ? reader.consumed - 1 : 0;
+        switch (error.code()) {
+            case DeserializationError::EmptyInput:
+                return DeserializeStatus::Failure(DeserializeError::EmptyInput, nullptr, offset);
+            case DeserializationError::IncompleteInput:
+                return DeserializeStatus::Failure(DeserializeError::IncompleteInput, nullptr, offset);
+            case DeserializationError::NoMemory:
+                return DeserializeStatus::Failure(DeserializeError::NoMemory, nullptr, offset);
+            case DeserializationError::TooDeep:
+                return DeserializeStatus::Failure(DeserializeError::TooDeep, nullptr, offset);
+            default:
+                return DeserializeStatus::Failure(DeserializeError::InvalidInput, nullptr, offset);
+        }
+    }
+    
+    /**
+     * Serialize a value directly into an existing JSON slot.
+     * Containers and nested values are written in place into the parent document,
+     * so a whole container is built as a single DOM and serialized once.
+     * 
+     * @tparam T The type to serialize
+     * @param value The value to serialize
+     * @param target The JSON slot to write into (document root, array element or object member)
+     */
+    template<typename T>
+    static void SerializeInto(const T& value, JsonVariant target) {
+        if constexpr (is_optional_type_v<T>) {
+            // Empty optionals become JSON null
+            if (value.has_value()) {
+                SerializeInto(value.value(), target);
+            } else {
+                target.set(nullptr);
+            }
+        } else if constexpr (is_primitive_type_v<T>) {
+            write_primitive_to_variant(value, target);
+        } else if constexpr (is_base64_bytes_v<T>) {
+            target.set(encode_base64(value));
+        } else if constexpr (is_sequential_container_v<T>) {
+            serialize_sequential_container_into(value, target.to<JsonArray>());
+        } else if constexpr (is_associative_container_v<T>) {
+            serialize_associative_container_into(value, target.to<JsonObject>());
+        } else if constexpr (std::is_enum_v<T>) {
+            // Enum specialization (S8_handle_enum_serialization.py) returns the plain name, e.g. "Off"
+            StdString enumStr = Serialize(value);
+            target.set(enumStr.c_str());
+        } else if constexpr (has_serialize_to<T>::value) {
+            // Serializable object: fill its fields directly into the slot
+            value.SerializeTo(target.to<JsonObject>());
+        } else {
+            // Serializable object without SerializeTo: parse its JSON once into the slot
+            StdString elementJson = value.Serialize();
+            DocumentLease elementLease = SerializationContext::Default().AcquireDocument();
+            JsonDocument& elementDoc = elementLease.Document();
+            DeserializationError error = deserializeJson(elementDoc, elementJson.c_str());
+            if (error == DeserializationError::Ok) {
+                target.set(elementDoc.as<JsonVariantConst>());
+            } else {
+                // If parsing fails, add as string (shouldn't happen for valid JSON)
+                target.set(elementJson.c_str());
+            }
+        }
+    }
+    
+    /**
+     * Write a primitive value into a JSON slot using its native JSON type.
+     */
+    template<typename T>
+    static void write_primitive_to_variant(const T& value, JsonVariant target) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            target.set(static_cast<bool>(value));
+        } else if constexpr (std::is_same_v<T, StdString> ||
+                             std::is_same_v<T, CStdString> ||
+                             std::is_same_v<T, std::string>) {
+            target.set(value.c_str());
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (std::is_signed_v<T>) {
+                target.set(static_cast<int64_t>(value));
+            } else {
+                target.set(static_cast<uint64_t>(value));
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            target.set(static_cast<double>(value));
+        } else {
+            // Fallback: store the string representation
+            StdString valueStr = convert_primitive_to_string(value);
+            target.set(valueStr.c_str());
+        }
+    }
+    
+    /**
+     * Write a primitive value through a Writer using its native type (same mapping as write_primitive_to_variant).
+     */
+    template<typename Writer, typename T>
+    static void write_primitive_to(Writer& writer, const T& value) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+            writer.WriteBool(static_cast<bool>(value));
+        } else if constexpr (std::is_same_v<T, StdString> ||
+                             std::is_same_v<T, CStdString> ||
+                             std::is_same_v<T, std::string>) {
+            writer.WriteString(value.data(), value.size());
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (std::is_signed_v<T>) {
+                writer.WriteInt(static_cast<int64_t>(value));
+            } else {
+                writer.WriteUInt(static_cast<uint64_t>(value));
+            }
+        } else if constexpr (std::is_same_v<T, float>) {
+            writer.WriteFloat(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            writer.WriteDouble(static_cast<double>(value));
+        } else {
+            StdString valueStr = convert_primitive_to_string(value);
+            writer.WriteString(valueStr.data(), valueStr.size());
+        }
+    }
+    
+    /**
+     * Write a parsed JSON value through a Writer.
+     */
+    template<typename Writer>
+    static void write_variant(Writer& writer, JsonVariantConst value) {
+        if (value.isNull()) {
+            writer.WriteNull();
+        } else if (value.is<bool>()) {
+            writer.WriteBool(value.as<bool>());
+        } else if (value.is<int64_t>()) {
+            writer.WriteInt(value.as<int64_t>());
+        } else if (value.is<uint64_t>()) {
+            writer.WriteUInt(value.as<uint64_t>());
+        } else if (value.is<double>()) {
+            writer.WriteDouble(value.as<double>());
+        } else if (value.is<const char*>()) {
+            const char* str = value.as<const char*>();
+            writer.WriteString(str, std::strlen(str));
+        } else if (value.is<JsonArrayConst>()) {
+            JsonArrayConst array = value.as<JsonArrayConst>();
+            writer.BeginArray(array.size());
+            for (JsonVariantConst element : array) {
+                write_variant(writer, element);
+            }
+            writer.EndArray();
+        } else if (value.is<JsonObjectConst>()) {
+            JsonObjectConst object = value.as<JsonObjectConst>();
+            writer.BeginObject(object.size());
+            for (JsonPairConst pair : object) {
+                const char* key = pair.key().c_str();
+                writer.Key(key, std::strlen(key));
+                write_variant(writer, pair.value());
+            }
+            writer.EndObject();
+        } else {
+            writer.WriteNull();
+        }
+    }
+    
+    template<typename Reader>
+    static DeserializeStatus read_failure(const Reader& reader, DeserializeError error) {
+        return DeserializeStatus::Failure(error, nullptr, reader.Position());
+    }
+
+    // Offset of the next value (after any whitespace)
+    template<typename Reader>
+    static size_t value_start(Reader& reader) {
+        reader.Peek();
+        return reader.Position();
+    }
+
+    /**
+     * A value that is well-formed but not acceptable (wrong type, out of range, unknown name, bad
+     * base64) is reported at its start; syntax errors are reported where the reader stopped.
+     */
+    template<typename Reader>
+    static DeserializeStatus value_failure(const Reader& reader, size_t start, DeserializeError error) {
+        bool syntaxError = error == DeserializeError::InvalidInput || error == DeserializeError::IncompleteInput ||
+                           error == DeserializeError::TooDeep;
+        return DeserializeStatus::Failure(error, nullptr, syntaxError ? reader.Position() : start);
+    }
+    
+    /**
+     * Read a complete input through a Reader. Like deserializeJson, anything after the value is ignored.
+     * `out` is only modified on success.
+     */
+    template<typename Reader, typename T>
+    static DeserializeStatus read_value(Reader& reader, T& out) {
+        if (reader.Peek() == TokenType::End) {
+            return read_failure(reader, DeserializeError::EmptyInput);
+        }
+        T value{};
+        DeserializeStatus status = Read(reader, value);
+        if (status) {
+            out = std::move(value);
+        }
+        return status;
+    }
+    
+    /**
+     * Read a complete JSON input, through a structural index when the input is large and
+     * NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD is set.
+     */
+    template<typename T>
+    static DeserializeStatus read_json(const char* input, size_t length, T& out) {
+#if NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD != 0
+        // A flat array of numbers has no strings, so its index would only cost a pass
+        if (!is_numeric_array_v<T> && length >= NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD) {
+            JsonStructuralIndex index;
+            if (index.Build(input, length)) {
+                JsonReader reader(input, length, index);
+                return read_value(reader, out);
+            }
+        }
+#endif
+        JsonReader reader(input, length);
+        return read_value(reader, out);
+    }
+    
+    /**
+     * Read a value that must span the whole input (one array element or one line), so trailing
+     * characters are an error rather than ignored. `out` is only modified on success.
+     */
+    template<typename T>
+    static DeserializeStatus read_complete_value(const char* input, size_t length, T& out, const SerializationContext& context) {
+        if constexpr (is_readable<T>()) {
+            JsonReader reader(input, length);
+            T value{};
+            DeserializeStatus status = read_value(reader, value);
+            if (!status) {
+                return status;
+            }
+            if (reader.Finish() != DeserializeError::Ok) {
+                return read_failure(reader, DeserializeError::InvalidInput);
+            }
+            out = std::move(value);
+            return status;
+        } else {
+            return TryDeserialize(input, length, out, context);
+        }
+    }
+
+    static bool is_json_whitespace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    /**
+     * Consume whitespace from a SourceBuffer, reading more input as needed.
+     * Returns false when the input ends first.
+     */
+    template<typename Source>
+    static bool skip_source_whitespace(SourceBuffer<Source>& input) {
+        while (true) {
+            size_t count = 0;
+            while (count < input.Size() && is_json_whitespace(input.Data()[count])) {
+                ++count;
+            }
+            input.Consume(count);
+            if (input.Size() > 0) {
+                return true;
+            }
+            if (!input.Fill()) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * Status for an input that ended early: IoError when the source failed, `error` otherwise.
+     */
+    template<typename Source>
+    static DeserializeStatus source_end_status(const SourceBuffer<Source>& input, DeserializeError error) {
+        return DeserializeStatus::Failure(input.Failed() ? DeserializeError::IoError : error, nullptr, input.Position());
+    }
+
+    /**
+     * Resumable search for the end of one array element: the first ',' or ']' outside strings and
+     * nested objects/arrays. `position` is relative to the start of the element.
+     */
+    struct ElementScan {
+        size_t position = 0;
+        size_t depth = 0;
+        bool inString = false;
+        bool escaped = false;
+        bool found = false;
+    };
+
+    static DeserializeError scan_element(const char* data, size_t size, ElementScan& scan) {
+        while (scan.position < size) {
+            if (scan.inString) {
+                if (scan.escaped) {
+                    scan.escaped = false;
+                    ++scan.position;
+                    continue;
+                }
+                // Plain string content is skipped a vector at a time
+                scan.position += StringScanner::FindQuoteOrBackslash(data + scan.position, size - scan.position);
+                if (scan.position == size) {
+                    break;
+                }
+                if (data[scan.position] == '\\') {
+                    scan.escaped = true;
+                } else {
+                    scan.inString = false;
+                }
+                ++scan.position;
+                continue;
+            }
+            switch (data[scan.position]) {
+                case '"':
+                    scan.inString = true;
+                    break;
+                case '{':
+                case '[':
+                    ++scan.depth;
+                    break;
+                case '}':
+                case ']':
+                    if (scan.depth == 0) {
+                        if (data[scan.position] == '}') {
+                            return DeserializeError::InvalidInput;
+                        }
+                        scan.found = true;
+                        return DeserializeError::Ok;
+                    }
+                    --scan.depth;
+                    break;
+                case ',':
+                    if (scan.depth == 0) {
+                        scan.found = true;
+                        return DeserializeError::Ok;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            ++scan.position;
+        }
+        return DeserializeError::Ok;
+    }
+
+    /**
+     * Call an element callback; callbacks returning bool can stop the iteration.
+     */
+    template<typename Callback, typename T>
+    static bool invoke_element_callback(Callback& callback, T& value) {
+        if constexpr (std::is_same_v<decltype(callback(value)), bool>) {
+            return callback(value);
+        } else {
+            callback(value);
+            return true;
+        }
+    }
+
+    /**
+     * Throw a runtime_error describing a failed status (parse error, or the field that failed).
+     */
+    static void throw_status(const char* prefix, const DeserializeStatus& status) {
+        StdString errorMsg = status_message(prefix, status);
+        NAYAN_SERIALIZER_THROW(std::runtime_error(errorMsg.c_str()));
+    }
+
+    /**
+     * Exception message for a failed status: the error code, the field and the offset, never the input.
+     */
+    static StdString status_message(const char* prefix, const DeserializeStatus& status) {
+        StdString errorMsg = prefix;
+        errorMsg += status.c_str();
+        if (status.field != nullptr) {
+            errorMsg += " in field '";
+            errorMsg += status.field;
+            errorMsg += "'";
+        }
+        if (status.offset != 0) {
+            errorMsg += " at offset ";
+            errorMsg += std::to_string(status.offset);
+        }
+        return errorMsg;
+    }
+
+    /**
+     * Short quoted excerpt of an input for exception messages, so a large or sensitive payload
+     * is not copied into the message.
+     */
+    static StdString input_excerpt(const StdString& input) {
+        constexpr size_t MaxExcerptLength = 32;
+        if (input.size() <= MaxExcerptLength) {
+            return "'" + input + "'";
+        }
+        return "'" + input.substr(0, MaxExcerptLength) + "...' (" + std::to_string(input.size()) + " characters)";
+    }
+    
+    /**
+     * Read a primitive value through a Reader (same rules as try_read_primitive_from_variant).
+     */
+    template<typename Reader, typename T>
+    static DeserializeError read_primitive_from(Reader& reader, T& out) {
+        TokenType token = reader.Peek();
+        if (token == TokenType::Null) {
+            DeserializeError error = reader.ReadNull();
+            if (error == DeserializeError::Ok) {
+                out = T();
+            }
+            return error;
+        }
+        if constexpr (std::is_same_v<T, StdString> ||
+                      std::is_same_v<T, CStdString> ||
+                      std::is_same_v<T, std::string>) {
+            if (token == TokenType::Bool) {
+                bool value = false;
+                DeserializeError error = reader.ReadBool(value);
+                if (error == DeserializeError::Ok) {
+                    out = value ? "true" : "false";
+                }
+                return error;
+            }
+            if (token == TokenType::Number) {
+                // Non-string value: keep its text
+                int64_t integer = 0;
+                uint64_t unsignedInteger = 0;
+                double number = 0;
+                if (reader.ReadInt(integer) == DeserializeError::Ok) {
+                    out = convert_primitive_to_string(integer);
+                } else if (reader.ReadUInt(unsignedInteger) == DeserializeError::Ok) {
+                    out = convert_primitive_to_string(unsignedInteger);
+                } else {
+                    DeserializeError error = reader.ReadDouble(number);
+                    if (error != DeserializeError::Ok) {
+                        return error;
+                    }
+                    out = convert_primitive_to_string(number);
+                }
+                return DeserializeError::Ok;
+            }
+            const char* text = nullptr;
+            size_t length = 0;
+            DeserializeError error = reader.ReadString(text, length);
+            if (error == DeserializeError::Ok) {
+                out.assign(text, length);
+            }
+            return error;
+        } else {
+            if (token == TokenType::String) {
+                const char* text = nullptr;
+                size_t length = 0;
+                DeserializeError error = reader.ReadString(text, length);
+                if (error != DeserializeError::Ok) {
+                    return error;
+                }
+                return try_convert_text_to_primitive(text, text + length, out);
+            }
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+                bool value = false;
+                DeserializeError error = reader.ReadBool(value);
+                if (error == DeserializeError::Ok) {
+                    out = value;
+                }
+                return error;
+            } else if constexpr (std::is_integral_v<T>) {
+                if constexpr (std::is_signed_v<T>) {
+                    int64_t value = 0;
+                    DeserializeError error = reader.ReadInt(value);
+                    if (error != DeserializeError::Ok) {
+                        return error;
+                    }
+                    if (value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+                        value > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                        return DeserializeError::OutOfRange;
+                    }
+                    out = static_cast<T>(value);
+                } else {
+                    uint64_t value = 0;
+                    DeserializeError error = reader.ReadUInt(value);
+                    if (error != DeserializeError::Ok) {
+                        return error;
+                    }
+                    if (value > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                        return DeserializeError::OutOfRange;
+                    }
+                    out = static_cast<T>(value);
+                }
+                return DeserializeError::Ok;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                double value = 0;
+                DeserializeError error = reader.ReadDouble(value);
+                if (error != DeserializeError::Ok) {
+                    return error;
+                }
+                if (value == value && (value > static_cast<double>(std::numeric_limits<T>::max()) ||
+                                       value < -static_cast<double>(std::numeric_limits<T>::max()))) {
+                    return DeserializeError::OutOfRange;
+                }
+                out = static_cast<T>(value);
+                return DeserializeError::Ok;
+            } else {
+                return token == TokenType::End ? DeserializeError::IncompleteInput : DeserializeError::TypeMismatch;
+            }
+        }
+    }
+    
+    /**
+     * Base64 text of a byte buffer (the content of the JSON string, without quotes).
+     */
+    template<typename Bytes>
+    static StdString encode_base64(const Bytes& bytes) {
+        StdString text(Base64::EncodedLength(bytes.size()), '\0');
+        Base64::Encode(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(), &text[0]);
+        return text;
+    }
+    
+    /**
+     * Decode base64 text into a byte buffer; `out` is only modified on success.
+     */
+    template<typename Bytes>
+    static DeserializeError decode_base64(const char* text, size_t length, Bytes& out) {
+        // The exact size is only known after the padding, so decoding fills a buffer of the upper bound
+        size_t written = 0;
+        if constexpr (has_resize<Bytes>::value) {
+            Bytes bytes;
+            bytes.resize(Base64::DecodedCapacity(length));
+            if (!Base64::Decode(text, length, reinterpret_cast<uint8_t*>(bytes.data()), written)) {
+                return DeserializeError::InvalidBase64;
+            }
+            bytes.resize(written);
+            out = std::move(bytes);
+            return DeserializeError::Ok;
+        } else {
+            StdVector<UInt8> bytes(Base64::DecodedCapacity(length));
+            if (!Base64::Decode(text, length, bytes.data(), written)) {
+                return DeserializeError::InvalidBase64;
+            }
+            return assign_bytes(bytes.data(), written, out);
+        }
+    }
     
     /**
-     * Convert a primitive type to StdString.
-     * Uses overloads for special cases.
+     * Copy raw bytes into a byte buffer; a fixed-size buffer must receive exactly its size.
+     * `out` is only modified on success.
      */
-    template<typename T>
-    static StdString convert_primitive_to_string(const T& value) {
-        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
-            return value ? "true" : "false";
-        } else if constexpr (std::is_same_v<T, StdString>) {
-            return value;
-        } else if constexpr (std::is_same_v<T, CStdString>) {
-            return StdString(value);
-        } else {
-            std::ostringstream oss;
-            oss << value;
-            return StdString(oss.str());
+    template<typename Bytes>
+    static DeserializeError assign_bytes(const uint8_t* data, size_t length, Bytes& out) {
+        if constexpr (has_resize<Bytes>::value) {
+            out.resize(length);
+        } else if (length != out.size()) {
+            return DeserializeError::SizeMismatch;
         }
+        if (length != 0) {
+            std::memcpy(out.data(), data, length);
+        }
+        return DeserializeError::Ok;
     }
     
     /**
-     * Convert a string to a primitive type.
-     * 
-     * @tparam T The primitive type to convert to
-     * @param input The string input
-     * @return The converted value of type T
+     * Read an array into a sequential container through a Reader.
+     * Elements are collected into a temporary, so `out` is only replaced on success.
      */
-    template<typename T>
-    static T convert_string_to_primitive(const StdString& input) {
-        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
-            // Handle boolean: "true", "false", "1", "0"
-            StdString lower = input;
-            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-            if (lower == "true" || lower == "1") {
-                return true;
-            } else if (lower == "false" || lower == "0") {
-                return false;
-            } else {
-                throw std::invalid_argument("Invalid boolean value: " + input);
+    template<typename Reader, typename Container>
+    static DeserializeStatus read_sequential_container(Reader& reader, Container& out) {
+        if constexpr (is_numeric_array_v<Container> && !is_std_array_type<Container>::value) {
+            // Plain numbers in one loop; strings, nulls or values out of range go element by element below
+            Container numbers;
+            if (reader.ReadNumbers(numbers)) {
+                out = std::move(numbers);
+                return DeserializeStatus::Success();
             }
-        } else if constexpr (std::is_same_v<T, StdString> || std::is_same_v<T, CStdString>) {
-            // Already a string, just return it
-            return input;
-        } else if constexpr (std::is_integral_v<T>) {
-            // Integer types
-            try {
-                if constexpr (std::is_signed_v<T>) {
-                    return static_cast<T>(std::stoll(input));
-                } else {
-                    return static_cast<T>(std::stoull(input));
+        }
+        DeserializeError error = reader.BeginArray();
+        if (error != DeserializeError::Ok) {
+            return read_failure(reader, error);
+        }
+        
+        using ValueType = typename Container::value_type;
+        Container container{};
+        size_t index = 0;
+        while (true) {
+            bool found = false;
+            error = reader.NextElement(found);
+            if (error != DeserializeError::Ok) {
+                return read_failure(reader, error);
+            }
+            if (!found) {
+                break;
+            }
+            // StdArray (fixed size) must match exactly
+            if constexpr (is_std_array_type<Container>::value) {
+                if (index >= std::tuple_size_v<Container>) {
+                    return read_failure(reader, DeserializeError::SizeMismatch);
                 }
-            } catch (const std::exception& e) {
-                throw std::invalid_argument("Invalid integer value: " + input);
             }
-        } else if constexpr (std::is_floating_point_v<T>) {
-            // Floating point types
-            try {
-                return static_cast<T>(std::stod(input));
-            } catch (const std::exception& e) {
-                throw std::invalid_argument("Invalid floating point value: " + input);
+            ValueType value{};
+            DeserializeStatus status = Read(reader, value);
+            if (!status) {
+                return status;
             }
-        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, Char> || std::is_same_v<T, CChar> ||
-                             std::is_same_v<T, unsigned char> || std::is_same_v<T, UChar> || std::is_same_v<T, CUChar> ||
-                             std::is_same_v<T, UInt8>) {
-            // Character types
-            if (input.length() == 1) {
-                return static_cast<T>(input[0]);
-            } else if (input.length() == 0) {
-                return static_cast<T>(0);
+            add_element<Container, ValueType>(container, std::move(value), index);
+            index++;
+        }
+        if constexpr (is_std_array_type<Container>::value) {
+            if (index != std::tuple_size_v<Container>) {
+                return read_failure(reader, DeserializeError::SizeMismatch);
+            }
+        }
+        
+        out = std::move(container);
+        return DeserializeStatus::Success();
+    }
+    
+    /**
+     * Read an object into an associative container through a Reader.
+     * Non-string keys are converted from their text form, as in try_deserialize_associative_container_from.
+     */
+    template<typename Reader, typename MapType>
+    static DeserializeStatus read_associative_container(Reader& reader, MapType& out) {
+        DeserializeError error = reader.BeginObject();
+        if (error != DeserializeError::Ok) {
+            return read_failure(reader, error);
+        }
+        
+        using KeyType = typename MapType::key_type;
+        using ValueType = typename MapType::mapped_type;
+        
+        MapType map;
+        while (true) {
+            bool found = false;
+            const char* keyText = nullptr;
+            size_t keyLength = 0;
+            error = reader.NextMember(found, keyText, keyLength);
+            if (error != DeserializeError::Ok) {
+                return read_failure(reader, error);
+            }
+            if (!found) {
+                break;
+            }
+            
+            KeyType key{};
+            if constexpr (std::is_same_v<KeyType, StdString> ||
+                          std::is_same_v<KeyType, CStdString> ||
+                          std::is_same_v<KeyType, std::string>) {
+                key.assign(keyText, keyLength);
             } else {
-                // Try to parse as integer for character types
-                try {
-                    return static_cast<T>(std::stoi(input));
-                } catch (const std::exception& e) {
-                    throw std::invalid_argument("Invalid character value: " + input);
+                DeserializeStatus keyStatus = TryDeserialize(keyText, keyLength, key);
+                if (!keyStatus) {
+                    keyStatus.offset = reader.Position();
+                    return keyStatus;
                 }
             }
-        } else {
-            // Fallback: try to use stringstream
-            std::istringstream iss(input);
-            T value;
-            if (!(iss >> value)) {
-                throw std::invalid_argument("Cannot convert string to type: " + input);
+            
+            ValueType value{};
+            DeserializeStatus status = Read(reader, value);
+            if (!status) {
+                return status;
             }
-            return value;
+            map[std::move(key)] = std::move(value);
         }
+        
+        out = std::move(map);
+        return DeserializeStatus::Success();
     }
     
     /**
      * Serialize a sequential container (vector, list, deque, set, etc.) to JSON array.
+     * The output is not reserved up front for the same reason as in Serialize(value, output).
      */
     template<typename Container>
     static StdString serialize_sequential_container(const Container& container) {
-        JsonDocument doc;
-        JsonArray array = doc.to<JsonArray>();
-        
+        StdString output;
+        JsonWriter<StdString> writer(output);
+        Write(writer, container);
+        return output;
+    }
+    
+    /**
+     * Serialize a sequential container into an existing JSON array.
+     * Each element is written straight into its own array slot.
+     */
+    template<typename Container>
+    static void serialize_sequential_container_into(const Container& container, JsonArray array) {
         // Special handling for vector<bool> which uses a proxy type
-        if constexpr (std::is_same_v<Container, std::vector<bool>> || std::is_same_v<Container, std::vector<bool>>) {
+        if constexpr (std::is_same_v<Container, std::vector<bool>>) {
             for (size_t i = 0; i < container.size(); ++i) {
                 bool boolValue = container[i];
                 array.add(boolValue);
             }
-        } else {
+        } else if constexpr (is_numeric_array_v<Container>) {
+            // Numbers go straight into their slots (same mapping as write_primitive_to_variant)
             for (const auto& element : container) {
-                if constexpr (is_primitive_type_v<typename Container::value_type>) {
-                    // For primitives, add directly to array
-                    if constexpr (std::is_same_v<typename Container::value_type, bool> || 
-                                  std::is_same_v<typename Container::value_type, Bool> ||
-                                  std::is_same_v<typename Container::value_type, CBool>) {
-                        array.add(element);
-                } else if constexpr (std::is_same_v<typename Container::value_type, StdString> ||
-                                     std::is_same_v<typename Container::value_type, CStdString> ||
-                                     std::is_same_v<typename Container::value_type, std::string>) {
-                    array.add(element.c_str());
-                } else if constexpr (std::is_integral_v<typename Container::value_type>) {
-                    array.add(static_cast<int64_t>(element));
-                } else if constexpr (std::is_floating_point_v<typename Container::value_type>) {
+                if constexpr (std::is_floating_point_v<typename Container::value_type>) {
                     array.add(static_cast<double>(element));
+                } else if constexpr (std::is_signed_v<typename Container::value_type>) {
+                    array.add(static_cast<int64_t>(element));
                 } else {
-                    // Fallback: serialize and parse
-                    StdString elementJson = Serialize(element);
-                    JsonDocument elemDoc;
-                    if (deserializeJson(elemDoc, elementJson.c_str()) == DeserializationError::Ok) {
-                        array.add(elemDoc.as<JsonVariant>());
-                    } else {
-                        array.add(elementJson.c_str());
-                    }
+                    array.add(static_cast<uint64_t>(element));
+                }
+            }
+        } else {
+            for (const auto& element : container) {
+                SerializeInto(element, array.add<JsonVariant>());
+            }
+        }
+    }
+    
+    /**
+     * Read a primitive value from a JSON value.
+     * Numbers and booleans sent as JSON strings are converted from their text form.
+     */
+    template<typename T>
+    static T read_primitive_from_variant(JsonVariantConst input) {
+        if constexpr (std::is_same_v<T, StdString> ||
+                      std::is_same_v<T, CStdString> ||
+                      std::is_same_v<T, std::string>) {
+            if (input.isNull()) {
+                return T();
+            }
+            const char* str = input.as<const char*>();
+            if (str != nullptr) {
+                return T(str);
+            }
+            // Non-string JSON value: keep its JSON text
+            StdString valueStr;
+            serializeJson(input, valueStr);
+            return T(valueStr);
+        } else {
+            if (input.is<const char*>()) {
+                return convert_string_to_primitive<T>(StdString(input.as<const char*>()));
+            }
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+                return input.as<bool>();
+            } else if constexpr (std::is_integral_v<T>) {
+                if constexpr (std::is_signed_v<T>) {
+                    return static_cast<T>(input.as<int64_t>());
+                } else {
+                    return static_cast<T>(input.as<uint64_t>());
                 }
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return static_cast<T>(input.as<double>());
+            } else {
+                // Fallback for other primitive types
+                StdString valueStr;
+                serializeJson(input, valueStr);
+                return convert_string_to_primitive<T>(valueStr);
+            }
+        }
+    }
+    
+    /**
+     * Read a primitive value from a JSON value without throwing.
+     * Unlike read_primitive_from_variant, numbers must have a matching JSON type and fit in T.
+     * JSON null keeps the default value, as with the throwing path.
+     */
+    template<typename T>
+    static DeserializeError try_read_primitive_from_variant(JsonVariantConst input, T& out) {
+        if constexpr (std::is_same_v<T, StdString> ||
+                      std::is_same_v<T, CStdString> ||
+                      std::is_same_v<T, std::string>) {
+            // Numbers and booleans keep their text (as in ReadFrom); objects and arrays are not strings
+            if (input.is<JsonObjectConst>() || input.is<JsonArrayConst>()) {
+                return DeserializeError::TypeMismatch;
+            }
+            out = read_primitive_from_variant<T>(input);
+            return DeserializeError::Ok;
+        } else {
+            if (input.isNull()) {
+                out = T();
+                return DeserializeError::Ok;
+            }
+            if (input.is<const char*>()) {
+                const char* str = input.as<const char*>();
+                return try_convert_text_to_primitive(str, str + std::strlen(str), out);
+            }
+            if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Bool> || std::is_same_v<T, CBool>) {
+                if (!input.is<bool>()) {
+                    return DeserializeError::TypeMismatch;
+                }
+                out = input.as<bool>();
+                return DeserializeError::Ok;
+            } else if constexpr (std::is_integral_v<T>) {
+                if constexpr (std::is_signed_v<T>) {
+                    if (!input.is<int64_t>()) {
+                        return input.is<uint64_t>() ? DeserializeError::OutOfRange : DeserializeError::TypeMismatch;
+                    }
+                    int64_t value = input.as<int64_t>();
+                    if (value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+                        value > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                        return DeserializeError::OutOfRange;
+                    }
+                    out = static_cast<T>(value);
                 } else {
-                    // For complex types, serialize to JSON string, then parse and add
-                    StdString elementJson = Serialize(element);
-                    JsonDocument elementDoc;
-                    DeserializationError error = deserializeJson(elementDoc, elementJson.c_str());
-                    if (error == DeserializationError::Ok) {
-                        array.add(elementDoc.as<JsonVariant>());
-                    } else {
-                        // If parsing fails, add as string (shouldn't happen for valid JSON)
-                        array.add(elementJson.c_str());
+                    if (!input.is<uint64_t>()) {
+                        return input.is<int64_t>() ? DeserializeError::OutOfRange : DeserializeError::TypeMismatch;
+                    }
+                    uint64_t value = input.as<uint64_t>();
+                    if (value > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                        return DeserializeError::OutOfRange;
                     }
+                    out = static_cast<T>(value);
+                }
+                return DeserializeError::Ok;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                if (!input.is<double>()) {
+                    return DeserializeError::TypeMismatch;
+                }
+                double value = input.as<double>();
+                if (value == value && (value > static_cast<double>(std::numeric_limits<T>::max()) ||
+                                       value < -static_cast<double>(std::numeric_limits<T>::max()))) {
+                    return DeserializeError::OutOfRange;
                 }
+                out = static_cast<T>(value);
+                return DeserializeError::Ok;
+            } else {
+                // Fallback for other primitive types
+                StdString valueStr;
+                serializeJson(input, valueStr);
+                return try_convert_text_to_primitive(valueStr.data(), valueStr.data() + valueStr.size(), out);
             }
         }
-        
-        StdString output;
-        serializeJson(doc, output);
-        return StdString(output.c_str());
     }
     
     /**
@@ -471,47 +2379,15 @@ public:
      * Handles different container insertion methods (push_back, insert, array indexing).
      */
     template<typename Container, typename ValueType>
-    static void deserialize_and_add_element(Container& container, const JsonVariant& element, size_t index) {
-        ValueType deserializedValue;
-        
-        if constexpr (is_primitive_type_v<ValueType>) {
-            // For primitive types, extract directly from JSON
-            if constexpr (std::is_same_v<ValueType, bool> || 
-                         std::is_same_v<ValueType, Bool> || 
-                         std::is_same_v<ValueType, CBool>) {
-                deserializedValue = element.as<bool>();
-            } else if constexpr (std::is_same_v<ValueType, StdString> ||
-                                 std::is_same_v<ValueType, CStdString> ||
-                                 std::is_same_v<ValueType, std::string>) {
-                const char* str = element.as<const char*>();
-                deserializedValue = ValueType(str ? str : "");
-            } else if constexpr (std::is_integral_v<ValueType>) {
-                if constexpr (std::is_signed_v<ValueType>) {
-                    deserializedValue = static_cast<ValueType>(element.as<int64_t>());
-                } else {
-                    deserializedValue = static_cast<ValueType>(element.as<uint64_t>());
-                }
-            } else if constexpr (std::is_floating_point_v<ValueType>) {
-                deserializedValue = static_cast<ValueType>(element.as<double>());
-            } else {
-                // Fallback for other primitive types
-                StdString elementStr;
-                serializeJson(element, elementStr);
-                deserializedValue = convert_string_to_primitive<ValueType>(elementStr);
-            }
-        } else if constexpr (std::is_enum_v<ValueType>) {
-            // For enums, deserialize from string
-            StdString elementStr;
-            serializeJson(element, elementStr); // Convert JsonVariant to string
-            deserializedValue = SerializationUtility::Deserialize<ValueType>(elementStr);
-        } else {
-            // For complex types (like ProductX), serialize the element to JSON string
-            // and call the type's Deserialize method
-            StdString elementJson;
-            serializeJson(element, elementJson);
-            deserializedValue = ValueType::Deserialize(elementJson);
-        }
-        
+    static void deserialize_and_add_element(Container& container, JsonVariantConst element, size_t index) {
+        add_element<Container, ValueType>(container, DeserializeFrom<ValueType>(element), index);
+    }
+    
+    /**
+     * Helper function to add an already deserialized element to a container.
+     */
+    template<typename Container, typename ValueType>
+    static void add_element(Container& container, ValueType&& deserializedValue, size_t index) {
         // Add to container based on container type
         // Helper to detect if container is StdSet/StdUnorderedSet
         constexpr bool isSetType = std::is_same_v<Container, std::set<ValueType>> ||
@@ -526,22 +2402,22 @@ public:
         
         if constexpr (isSetType) {
             // StdSet and StdUnorderedSet use insert
-            container.insert(deserializedValue);
+            container.insert(std::move(deserializedValue));
         } else if constexpr (isArrayType) {
             // StdArray uses indexing (fixed size)
             if constexpr (std::is_array_v<Container>) {
                 if (index < std::extent_v<Container>) {
-                    container[index] = deserializedValue;
+                    container[index] = std::move(deserializedValue);
                 }
             } else {
                 // std::array or Array
                 if (index < container.size()) {
-                    container[index] = deserializedValue;
+                    container[index] = std::move(deserializedValue);
                 }
             }
         } else {
             // StdVector, StdList, StdDeque use push_back
-            container.push_back(deserializedValue);
+            container.push_back(std::move(deserializedValue));
         }
     }
     
@@ -554,21 +2430,49 @@ public:
      * @return The deserialized container
      */
     template<typename Container>
-    static Container deserialize_sequential_container(const StdString& input) {
-        // Parse the JSON string into a JsonDocument
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, input.c_str());
-        
-        if (error != DeserializationError::Ok) {
-            throw std::invalid_argument("Failed to parse JSON: " + input);
+    static Container deserialize_sequential_container(const StdString& input, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_readable<Container>()) {
+            // Single pass without a document; the status says what failed and where
+            Container container;
+            DeserializeStatus status = read_json(input.data(), input.size(), container);
+            if (!status) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument(status_message("JSON parse error: ", status)));
+            }
+            return container;
+        } else {
+            // Elements without ReadFrom: parse into a document from the context
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializationError error = deserializeJson(doc, input.c_str());
+            
+            if (error != DeserializationError::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument(StdString("JSON parse error: ") + error.c_str()));
+            }
+            
+            // Check if it's an array
+            if (!doc.is<JsonArray>()) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Expected JSON array"));
+            }
+            
+            return deserialize_sequential_container_from<Container>(doc.as<JsonVariantConst>());
         }
-        
+    }
+    
+    /**
+     * Deserialize a parsed JSON array to a sequential container.
+     * 
+     * @tparam Container The container type to deserialize to
+     * @param input The JSON array value
+     * @return The deserialized container
+     */
+    template<typename Container>
+    static Container deserialize_sequential_container_from(JsonVariantConst input) {
         // Check if it's an array
-        if (!doc.is<JsonArray>()) {
-            throw std::invalid_argument("Expected JSON array, got: " + input);
+        if (!input.is<JsonArrayConst>()) {
+            NAYAN_SERIALIZER_THROW(std::invalid_argument("Expected JSON array"));
         }
         
-        JsonArray jsonArray = doc.as<JsonArray>();
+        JsonArrayConst jsonArray = input.as<JsonArrayConst>();
         Container container;
         
         // Get the value type of the container
@@ -579,21 +2483,25 @@ public:
             // C-style array
             constexpr size_t arraySize = std::extent_v<Container>;
             if (jsonArray.size() != arraySize) {
-                throw std::invalid_argument("JSON array size (" + std::to_string(jsonArray.size()) + 
-                                          ") does not match StdArray size (" + std::to_string(arraySize) + ")");
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("JSON array size (" + std::to_string(jsonArray.size()) + 
+                                          ") does not match StdArray size (" + std::to_string(arraySize) + ")"));
             }
         } else if constexpr (is_std_array_type<Container>::value) {
             // std::array or StdArray - validate size
             constexpr size_t arraySize = std::tuple_size_v<Container>;
             if (jsonArray.size() != arraySize) {
-                throw std::invalid_argument("JSON array size (" + std::to_string(jsonArray.size()) + 
-                                          ") does not match StdArray size (" + std::to_string(arraySize) + ")");
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("JSON array size (" + std::to_string(jsonArray.size()) + 
+                                          ") does not match StdArray size (" + std::to_string(arraySize) + ")"));
             }
         }
         
+        if constexpr (is_numeric_array_v<Container> && !is_std_array_type<Container>::value) {
+            container.reserve(jsonArray.size());
+        }
+        
         // Iterate through each element in the JSON array
         size_t index = 0;
-        for (JsonVariant element : jsonArray) {
+        for (JsonVariantConst element : jsonArray) {
             deserialize_and_add_element<Container, ValueType>(container, element, index);
             index++;
         }
@@ -601,6 +2509,45 @@ public:
         return container;
     }
     
+    /**
+     * Deserialize a parsed JSON array to a sequential container without throwing.
+     * Elements are collected into a temporary, so `out` is only replaced on success.
+     */
+    template<typename Container>
+    static DeserializeStatus try_deserialize_sequential_container_from(JsonVariantConst input, Container& out) {
+        if (!input.is<JsonArrayConst>()) {
+            return DeserializeStatus::Failure(DeserializeError::TypeMismatch);
+        }
+        
+        JsonArrayConst jsonArray = input.as<JsonArrayConst>();
+        using ValueType = typename Container::value_type;
+        
+        // StdArray (fixed size) must match exactly
+        if constexpr (is_std_array_type<Container>::value) {
+            if (jsonArray.size() != std::tuple_size_v<Container>) {
+                return DeserializeStatus::Failure(DeserializeError::SizeMismatch);
+            }
+        }
+        
+        Container container{};
+        if constexpr (is_numeric_array_v<Container> && !is_std_array_type<Container>::value) {
+            container.reserve(jsonArray.size());
+        }
+        size_t index = 0;
+        for (JsonVariantConst element : jsonArray) {
+            ValueType value{};
+            DeserializeStatus status = TryDeserializeFrom(element, value);
+            if (!status) {
+                return status;
+            }
+            add_element<Container, ValueType>(container, std::move(value), index);
+            index++;
+        }
+        
+        out = std::move(container);
+        return DeserializeStatus::Success();
+    }
+    
     /**
      * Deserialize a JSON object string to an associative container (StdMap, StdUnorderedMap).
      * 
@@ -609,21 +2556,49 @@ public:
      * @return The deserialized map
      */
     template<typename MapType>
-    static MapType deserialize_associative_container(const StdString& input) {
-        // Parse the JSON string into a JsonDocument
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, input.c_str());
-        
-        if (error != DeserializationError::Ok) {
-            throw std::invalid_argument("Failed to parse JSON: " + input);
+    static MapType deserialize_associative_container(const StdString& input, const SerializationContext& context = SerializationContext::Default()) {
+        if constexpr (is_readable<MapType>()) {
+            // Single pass without a document; the status says what failed and where
+            MapType map;
+            DeserializeStatus status = read_json(input.data(), input.size(), map);
+            if (!status) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument(status_message("JSON parse error: ", status)));
+            }
+            return map;
+        } else {
+            // Values without ReadFrom: parse into a document from the context
+            DocumentLease lease = context.AcquireDocument();
+            JsonDocument& doc = lease.Document();
+            DeserializationError error = deserializeJson(doc, input.c_str());
+            
+            if (error != DeserializationError::Ok) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument(StdString("JSON parse error: ") + error.c_str()));
+            }
+            
+            // Check if it's an object
+            if (!doc.is<JsonObject>()) {
+                NAYAN_SERIALIZER_THROW(std::invalid_argument("Expected JSON object"));
+            }
+            
+            return deserialize_associative_container_from<MapType>(doc.as<JsonVariantConst>());
         }
-        
+    }
+    
+    /**
+     * Deserialize a parsed JSON object to an associative container.
+     * 
+     * @tparam MapType The map type to deserialize to
+     * @param input The JSON object value
+     * @return The deserialized map
+     */
+    template<typename MapType>
+    static MapType deserialize_associative_container_from(JsonVariantConst input) {
         // Check if it's an object
-        if (!doc.is<JsonObject>()) {
-            throw std::invalid_argument("Expected JSON object, got: " + input);
+        if (!input.is<JsonObjectConst>()) {
+            NAYAN_SERIALIZER_THROW(std::invalid_argument("Expected JSON object"));
         }
         
-        JsonObject jsonObject = doc.as<JsonObject>();
+        JsonObjectConst jsonObject = input.as<JsonObjectConst>();
         MapType map;
         
         // Get the key and value types
@@ -631,7 +2606,7 @@ public:
         using ValueType = typename MapType::mapped_type;
         
         // Iterate through each key-value pair in the JSON object
-        for (JsonPair pair : jsonObject) {
+        for (JsonPairConst pair : jsonObject) {
             // Deserialize the key
             KeyType key;
             if constexpr (is_primitive_type_v<KeyType>) {
@@ -639,17 +2614,6 @@ public:
                              std::is_same_v<KeyType, CStdString> ||
                              std::is_same_v<KeyType, std::string>) {
                     key = KeyType(pair.key().c_str());
-                } else if constexpr (std::is_same_v<KeyType, bool> ||
-                                     std::is_same_v<KeyType, Bool> ||
-                                     std::is_same_v<KeyType, CBool>) {
-                    StdString keyStr = StdString(pair.key().c_str());
-                    key = convert_string_to_primitive<KeyType>(keyStr);
-                } else if constexpr (std::is_integral_v<KeyType>) {
-                    StdString keyStr = StdString(pair.key().c_str());
-                    key = convert_string_to_primitive<KeyType>(keyStr);
-                } else if constexpr (std::is_floating_point_v<KeyType>) {
-                    StdString keyStr = StdString(pair.key().c_str());
-                    key = convert_string_to_primitive<KeyType>(keyStr);
                 } else {
                     StdString keyStr = StdString(pair.key().c_str());
                     key = convert_string_to_primitive<KeyType>(keyStr);
@@ -660,45 +2624,52 @@ public:
                 key = KeyType::Deserialize(keyJson);
             }
             
-            // Deserialize the value
-            ValueType value;
-            if constexpr (is_primitive_type_v<ValueType>) {
-                // For primitive types, extract directly from JSON
-                if constexpr (std::is_same_v<ValueType, bool> ||
-                             std::is_same_v<ValueType, Bool> ||
-                             std::is_same_v<ValueType, CBool>) {
-                    value = pair.value().as<bool>();
-                } else if constexpr (std::is_same_v<ValueType, StdString> ||
-                                     std::is_same_v<ValueType, CStdString> ||
-                                     std::is_same_v<ValueType, std::string>) {
-                    const char* str = pair.value().as<const char*>();
-                    value = ValueType(str ? str : "");
-                } else if constexpr (std::is_integral_v<ValueType>) {
-                    if constexpr (std::is_signed_v<ValueType>) {
-                        value = static_cast<ValueType>(pair.value().as<int64_t>());
-                    } else {
-                        value = static_cast<ValueType>(pair.value().as<uint64_t>());
-                    }
-                } else if constexpr (std::is_floating_point_v<ValueType>) {
-                    value = static_cast<ValueType>(pair.value().as<double>());
-                } else {
-                    // Fallback for other primitive types
-                    StdString valueStr;
-                    serializeJson(pair.value(), valueStr);
-                    value = convert_string_to_primitive<ValueType>(valueStr);
-                }
+            // Deserialize the value straight from the JSON tree and insert into map
+            map[key] = DeserializeFrom<ValueType>(pair.value());
+        }
+        
+        return map;
+    }
+    
+    /**
+     * Deserialize a parsed JSON object to an associative container without throwing.
+     * Non-string keys are converted from their text form (enum names, numbers or JSON for complex keys).
+     */
+    template<typename MapType>
+    static DeserializeStatus try_deserialize_associative_container_from(JsonVariantConst input, MapType& out) {
+        if (!input.is<JsonObjectConst>()) {
+            return DeserializeStatus::Failure(DeserializeError::TypeMismatch);
+        }
+        
+        using KeyType = typename MapType::key_type;
+        using ValueType = typename MapType::mapped_type;
+        
+        MapType map;
+        for (JsonPairConst pair : input.as<JsonObjectConst>()) {
+            KeyType key{};
+            if constexpr (std::is_same_v<KeyType, StdString> ||
+                          std::is_same_v<KeyType, CStdString> ||
+                          std::is_same_v<KeyType, std::string>) {
+                key = KeyType(pair.key().c_str());
             } else {
-                // For complex types, serialize the value to JSON string and call Deserialize
-                StdString valueJson;
-                serializeJson(pair.value(), valueJson);
-                value = ValueType::Deserialize(valueJson);
+                // Map keys are not reported as field names: they do not outlive the document
+                DeserializeStatus keyStatus = TryDeserialize(pair.key().c_str(), std::strlen(pair.key().c_str()), key);
+                if (!keyStatus) {
+                    keyStatus.offset = 0;
+                    return keyStatus;
+                }
             }
             
-            // Insert into map
-            map[key] = value;
+            ValueType value{};
+            DeserializeStatus status = TryDeserializeFrom(pair.value(), value);
+            if (!status) {
+                return status;
+            }
+            map[std::move(key)] = std::move(value);
         }
         
-        return map;
+        out = std::move(map);
+        return DeserializeStatus::Success();
     }
     
     /**
@@ -706,68 +2677,33 @@ public:
      */
     template<typename Map>
     static StdString serialize_associative_container(const Map& map) {
-        JsonDocument doc;
-        JsonObject obj = doc.to<JsonObject>();
-        
+        StdString output;
+        JsonWriter<StdString> writer(output);
+        Write(writer, map);
+        return output;
+    }
+    
+    /**
+     * Serialize an associative container into an existing JSON object.
+     * Each value is written straight into its member slot.
+     */
+    template<typename Map>
+    static void serialize_associative_container_into(const Map& map, JsonObject obj) {
         for (const auto& pair : map) {
             // Serialize key
-            StdString keyJson = Serialize(pair.first);
             StdString keyStr;
-            
-            if (is_primitive_type_v<typename Map::key_type>) {
-                if constexpr (std::is_same_v<typename Map::key_type, StdString> ||
-                              std::is_same_v<typename Map::key_type, CStdString> ||
-                              std::is_same_v<typename Map::key_type, std::string>) {
-                    keyStr = pair.first;
-                } else {
-                    keyStr = keyJson;
-                }
+            if constexpr (std::is_same_v<typename Map::key_type, StdString> ||
+                          std::is_same_v<typename Map::key_type, CStdString> ||
+                          std::is_same_v<typename Map::key_type, std::string>) {
+                keyStr = pair.first;
             } else {
-                // For complex key types, use the serialized JSON as key (may need adjustment)
-                keyStr = keyJson;
+                // For primitive keys use the string form; for complex key types use the serialized JSON
+                keyStr = Serialize(pair.first);
             }
             
-            // Serialize value
-            StdString valueJson = Serialize(pair.second);
-            
-            // Parse value JSON and add to object
-            JsonDocument valueDoc;
-            DeserializationError error = deserializeJson(valueDoc, valueJson.c_str());
-            if (error == DeserializationError::Ok) {
-                obj[keyStr.c_str()] = valueDoc.as<JsonVariant>();
-            } else {
-                // If value is primitive, add directly
-                if (is_primitive_type_v<typename Map::mapped_type>) {
-                    if constexpr (std::is_same_v<typename Map::mapped_type, bool> ||
-                                  std::is_same_v<typename Map::mapped_type, Bool> ||
-                                  std::is_same_v<typename Map::mapped_type, CBool>) {
-                        obj[keyStr.c_str()] = pair.second;
-                    } else if constexpr (std::is_same_v<typename Map::mapped_type, StdString> ||
-                                         std::is_same_v<typename Map::mapped_type, CStdString> ||
-                                         std::is_same_v<typename Map::mapped_type, std::string>) {
-                        obj[keyStr.c_str()] = pair.second.c_str();
-                    } else if constexpr (std::is_integral_v<typename Map::mapped_type>) {
-                        obj[keyStr.c_str()] = static_cast<int64_t>(pair.second);
-                    } else if constexpr (std::is_floating_point_v<typename Map::mapped_type>) {
-                        obj[keyStr.c_str()] = static_cast<double>(pair.second);
-                    } else {
-                        obj[keyStr.c_str()] = valueJson.c_str();
-                    }
-                } else {
-                    // For complex types, parse and add
-                    JsonDocument valDoc;
-                    if (deserializeJson(valDoc, valueJson.c_str()) == DeserializationError::Ok) {
-                        obj[keyStr.c_str()] = valDoc.as<JsonVariant>();
-                    } else {
-                        obj[keyStr.c_str()] = valueJson.c_str();
-                    }
-                }
-            }
+            // Serialize value in place
+            SerializeInto(pair.second, obj[keyStr.c_str()].template to<JsonVariant>());
         }
-        
-        StdString output;
-        serializeJson(doc, output);
-        return StdString(output.c_str());
     }
 };
 
@@ -803,8 +2739,8 @@ StdString SerializeValue(const T& value) {
     if constexpr (is_primitive) {
         // Handle primitive types
         return SerializationUtility::convert_primitive_to_string(value);
-    } else if constexpr (SerializationUtility::is_sequential_container_v<T>) {
-        // Handle sequential containers (vector, list, deque, etc.)
+    } else if constexpr (SerializationUtility::is_sequential_container_v<T> || SerializationUtility::is_base64_bytes_v<T>) {
+        // Handle sequential containers (vector, list, deque, etc.) and base64 byte buffers
         return SerializationUtility::Serialize(value);
     } else if constexpr (std::is_enum_v<T>) {
         // Handle enum types - template specialization should be provided by S8_handle_enum_serialization.py
@@ -856,7 +2792,8 @@ remove_cvref_t<ReturnType> DeserializeValue(const StdString& input) {
         // Handle enum types - use template specialization if available
         return SerializationUtility::Deserialize<ValueType>(input);
     } else if constexpr (SerializationUtility::is_sequential_container_v<ValueType> || 
-                         SerializationUtility::is_associative_container_v<ValueType>) {
+                         SerializationUtility::is_associative_container_v<ValueType> ||
+                         SerializationUtility::is_base64_bytes_v<ValueType>) {
         // Handle containers - use SerializationUtility::Deserialize
         return SerializationUtility::Deserialize<ValueType>(input);
     } else {
@@ -0,0 +1,553 @@
+#ifndef SERIALIZATION_WRITER_H
+#define SERIALIZATION_WRITER_H
+
+#include <StandardDefines.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "NumericConversionUtility.h"
+#include "StringScanner.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Writer concept
+ *
+ * SerializationUtility::Write and the generated WriteTo methods produce output through a Writer,
+ * so every output format is one backend instead of another round of code generation.
+ * A Writer provides:
+ *
+ *   void BeginObject();                          // followed by Key/value pairs
+ *   void BeginObject(size_t count);              // same, when the number of pairs is known
+ *   void EndObject();
+ *   void BeginArray();                           // followed by values
+ *   void BeginArray(size_t count);               // same, when the number of values is known
+ *   void EndArray();
+ *   void Key(const char* key, size_t length);    // member name inside an object
+ *   void WriteNull();
+ *   void WriteBool(bool value);
+ *   void WriteInt(int64_t value);
+ *   void WriteUInt(uint64_t value);
+ *   void WriteFloat(float value);
+ *   void WriteDouble(double value);
+ *   void WriteString(const char* data, size_t length);
+ *   template<typename T> void WriteNumbers(const T* values, size_t count);  // whole array of integers or floating point values
+ *
+ * Backends: JsonWriter (JSON text into a string, a fixed buffer or a CharCounter),
+ * CountingWriter (length of the JSON text, nothing written) and MsgPackWriter (MessagePack).
+ */
+
+/**
+ * JsonWriter output that only counts characters.
+ */
+struct CharCounter {
+    size_t size = 0;
+
+    void append(const char* data, size_t length) {
+        (void)data;
+        size += length;
+    }
+
+    void push_back(char c) {
+        (void)c;
+        ++size;
+    }
+};
+
+/**
+ * JsonWriter output over a caller-provided buffer.
+ * Writing stops at the end of the buffer and sets `overflow`.
+ */
+struct FixedBufferOutput {
+    char* buffer;
+    size_t capacity;
+    size_t size = 0;
+    bool overflow = false;
+
+    FixedBufferOutput(char* buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    void append(const char* data, size_t length) {
+        if (overflow || length > capacity - size) {
+            overflow = true;
+            return;
+        }
+        std::memcpy(buffer + size, data, length);
+        size += length;
+    }
+
+    void push_back(char c) {
+        if (overflow || size == capacity) {
+            overflow = true;
+            return;
+        }
+        buffer[size++] = c;
+    }
+};
+
+/**
+ * Writes compact JSON text (same layout as serializeJson) without building a document.
+ *
+ * @tparam Output StdString, FixedBufferOutput, CharCounter or any type with append(const char*, size_t) and push_back(char)
+ */
+template<typename Output = StdString>
+class JsonWriter {
+public:
+    explicit JsonWriter(Output& output) : output_(output), first_(true), afterKey_(false) {}
+
+    void BeginObject() {
+        separate();
+        output_.push_back('{');
+        first_ = true;
+    }
+
+    void BeginObject(size_t) {
+        BeginObject();
+    }
+
+    void EndObject() {
+        output_.push_back('}');
+        first_ = false;
+    }
+
+    void BeginArray() {
+        separate();
+        output_.push_back('[');
+        first_ = true;
+    }
+
+    void BeginArray(size_t) {
+        BeginArray();
+    }
+
+    void EndArray() {
+        output_.push_back(']');
+        first_ = false;
+    }
+
+    void Key(const char* key, size_t length) {
+        separate();
+        write_quoted(key, length);
+        output_.push_back(':');
+        afterKey_ = true;
+    }
+
+    void WriteNull() {
+        separate();
+        output_.append("null", 4);
+    }
+
+    void WriteBool(bool value) {
+        separate();
+        if (value) {
+            output_.append("true", 4);
+        } else {
+            output_.append("false", 5);
+        }
+    }
+
+    void WriteInt(int64_t value) {
+        separate();
+        write_number(value);
+    }
+
+    void WriteUInt(uint64_t value) {
+        separate();
+        write_number(value);
+    }
+
+    void WriteFloat(float value) {
+        separate();
+        // JSON has no NaN/Infinity
+        if (!std::isfinite(value)) {
+            output_.append("null", 4);
+            return;
+        }
+        write_number(value);
+    }
+
+    void WriteDouble(double value) {
+        separate();
+        if (!std::isfinite(value)) {
+            output_.append("null", 4);
+            return;
+        }
+        write_number(value);
+    }
+
+    void WriteString(const char* data, size_t length) {
+        separate();
+        write_quoted(data, length);
+    }
+
+    /**
+     * Same text as BeginArray, one Write per value and EndArray; the elements are formatted
+     * into a stack block and appended a block at a time.
+     */
+    template<typename T>
+    void WriteNumbers(const T* values, size_t count) {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "WriteNumbers requires an integer or floating point type");
+        separate();
+        char block[512];
+        size_t used = 0;
+        block[used++] = '[';
+        for (size_t i = 0; i < count; ++i) {
+            // Room for a separator, the longest number and the closing bracket
+            if (sizeof(block) - used < NumericConversionUtility::MaxFormattedLength + 2) {
+                output_.append(block, used);
+                used = 0;
+            }
+            if (i != 0) {
+                block[used++] = ',';
+            }
+            if constexpr (std::is_floating_point_v<T>) {
+                if (!std::isfinite(values[i])) {
+                    std::memcpy(block + used, "null", 4);
+                    used += 4;
+                    continue;
+                }
+            }
+            size_t length = 0;
+            NumericConversionUtility::FormatNumber(values[i], block + used, sizeof(block) - used, length);
+            used += length;
+        }
+        block[used++] = ']';
+        output_.append(block, used);
+        first_ = false;
+    }
+
+private:
+    // Comma before every value except the first of a container and the value after a key
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+        } else if (!first_) {
+            output_.push_back(',');
+        }
+        first_ = false;
+    }
+
+    template<typename T>
+    void write_number(T value) {
+        char buffer[NumericConversionUtility::MaxFormattedLength];
+        size_t length = 0;
+        NumericConversionUtility::FormatNumber(value, buffer, sizeof(buffer), length);
+        output_.append(buffer, length);
+    }
+
+    void write_quoted(const char* data, size_t length) {
+        output_.push_back('"');
+        // Copy runs of plain characters at once, escaping only where needed
+        size_t runStart = 0;
+        while (true) {
+            size_t i = runStart + StringScanner::FindEscapeCharacter(data + runStart, length - runStart);
+            output_.append(data + runStart, i - runStart);
+            if (i == length) {
+                break;
+            }
+            write_escaped(static_cast<unsigned char>(data[i]));
+            runStart = i + 1;
+        }
+        output_.push_back('"');
+    }
+
+    void write_escaped(unsigned char c) {
+        char escape = 0;
+        switch (c) {
+            case '"': escape = '"'; break;
+            case '\\': escape = '\\'; break;
+            case '\b': escape = 'b'; break;
+            case '\f': escape = 'f'; break;
+            case '\n': escape = 'n'; break;
+            case '\r': escape = 'r'; break;
+            case '\t': escape = 't'; break;
+            default: break;
+        }
+        if (escape != 0) {
+            char sequence[2] = {'\\', escape};
+            output_.append(sequence, 2);
+            return;
+        }
+        static const char hex[] = "0123456789abcdef";
+        char sequence[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+        output_.append(sequence, 6);
+    }
+
+    Output& output_;
+    bool first_;
+    bool afterKey_;
+};
+
+/**
+ * "Null" writer: computes the length of the JSON text JsonWriter would produce without writing it.
+ */
+class CountingWriter : private CharCounter, public JsonWriter<CharCounter> {
+public:
+    CountingWriter() : CharCounter(), JsonWriter<CharCounter>(static_cast<CharCounter&>(*this)) {}
+
+    /**
+     * Number of characters written so far.
+     */
+    size_t Count() const {
+        return CharCounter::size;
+    }
+};
+
+/**
+ * Writes MessagePack (same encoding as serializeMsgPack) without building a document.
+ * BeginObject(count) and BeginArray(count) write the final header straight away. Without a
+ * count, a one-byte header is reserved and widened when the container is closed with 16 or
+ * more entries, which moves everything written inside it.
+ */
+class MsgPackWriter {
+public:
+    explicit MsgPackWriter(StdString& output) : output_(output) {}
+
+    void BeginObject() {
+        begin_container(true);
+    }
+
+    void BeginObject(size_t count) {
+        begin_sized_container(count, true);
+    }
+
+    void EndObject() {
+        end_container();
+    }
+
+    void BeginArray() {
+        begin_container(false);
+    }
+
+    void BeginArray(size_t count) {
+        begin_sized_container(count, false);
+    }
+
+    void EndArray() {
+        end_container();
+    }
+
+    void Key(const char* key, size_t length) {
+        // Objects count their keys; the value that follows is not counted again
+        if (!frames_.empty()) {
+            ++frames_.back().count;
+        }
+        write_string(key, length);
+    }
+
+    void WriteNull() {
+        count_value();
+        output_.push_back(static_cast<char>(0xc0));
+    }
+
+    void WriteBool(bool value) {
+        count_value();
+        output_.push_back(static_cast<char>(value ? 0xc3 : 0xc2));
+    }
+
+    void WriteInt(int64_t value) {
+        count_value();
+        write_int(value);
+    }
+
+    void WriteUInt(uint64_t value) {
+        count_value();
+        write_uint(value);
+    }
+
+    void WriteFloat(float value) {
+        count_value();
+        write_float32(value);
+    }
+
+    void WriteDouble(double value) {
+        count_value();
+        write_double(value);
+    }
+
+    void WriteString(const char* data, size_t length) {
+        count_value();
+        write_string(data, length);
+    }
+
+    /**
+     * Same bytes as BeginArray, one Write per value and EndArray; the element count is known,
+     * so the header is written once at its final size and the output grows once.
+     */
+    template<typename T>
+    void WriteNumbers(const T* values, size_t count) {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "WriteNumbers requires an integer or floating point type");
+        count_value();
+        char header[5];
+        size_t headerLength = container_header(header, static_cast<uint32_t>(count), false);
+        // Largest encoding: type byte and 8 value bytes
+        output_.reserve(output_.size() + headerLength + count * 9);
+        output_.append(header, headerLength);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_same_v<T, float>) {
+                write_float32(values[i]);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                write_double(static_cast<double>(values[i]));
+            } else if constexpr (std::is_signed_v<T>) {
+                write_int(static_cast<int64_t>(values[i]));
+            } else {
+                write_uint(static_cast<uint64_t>(values[i]));
+            }
+        }
+    }
+
+private:
+    struct Frame {
+        size_t headerPosition;
+        uint32_t count;
+        bool isObject;
+        // The header was written with its final count
+        bool sized;
+    };
+
+    void count_value() {
+        if (!frames_.empty() && !frames_.back().isObject) {
+            ++frames_.back().count;
+        }
+    }
+
+    void begin_container(bool isObject) {
+        count_value();
+        frames_.push_back(Frame{output_.size(), 0, isObject, false});
+        output_.push_back('\0');
+    }
+
+    void begin_sized_container(size_t count, bool isObject) {
+        count_value();
+        frames_.push_back(Frame{output_.size(), 0, isObject, true});
+        char header[5];
+        output_.append(header, container_header(header, static_cast<uint32_t>(count), isObject));
+    }
+
+    void end_container() {
+        Frame frame = frames_.back();
+        frames_.pop_back();
+        if (frame.sized) {
+            return;
+        }
+
+        char header[5];
+        size_t headerLength = container_header(header, frame.count, frame.isObject);
+        if (headerLength > 1) {
+            output_.insert(frame.headerPosition + 1, headerLength - 1, '\0');
+        }
+        std::memcpy(&output_[frame.headerPosition], header, headerLength);
+    }
+
+    void write_int(int64_t value) {
+        if (value >= 0) {
+            write_uint(static_cast<uint64_t>(value));
+            return;
+        }
+        if (value >= -32) {
+            output_.push_back(static_cast<char>(value));
+        } else if (value >= INT8_MIN) {
+            output_.push_back(static_cast<char>(0xd0));
+            write_big_endian(static_cast<uint8_t>(value), 1);
+        } else if (value >= INT16_MIN) {
+            output_.push_back(static_cast<char>(0xd1));
+            write_big_endian(static_cast<uint16_t>(value), 2);
+        } else if (value >= INT32_MIN) {
+            output_.push_back(static_cast<char>(0xd2));
+            write_big_endian(static_cast<uint32_t>(value), 4);
+        } else {
+            output_.push_back(static_cast<char>(0xd3));
+            write_big_endian(static_cast<uint64_t>(value), 8);
+        }
+    }
+
+    void write_uint(uint64_t value) {
+        if (value < 0x80) {
+            output_.push_back(static_cast<char>(value));
+        } else if (value <= UINT8_MAX) {
+            output_.push_back(static_cast<char>(0xcc));
+            write_big_endian(value, 1);
+        } else if (value <= UINT16_MAX) {
+            output_.push_back(static_cast<char>(0xcd));
+            write_big_endian(value, 2);
+        } else if (value <= UINT32_MAX) {
+            output_.push_back(static_cast<char>(0xce));
+            write_big_endian(value, 4);
+        } else {
+            output_.push_back(static_cast<char>(0xcf));
+            write_big_endian(value, 8);
+        }
+    }
+
+    void write_double(double value) {
+        // Doubles that survive the round trip through float are written as float 32, like serializeMsgPack
+        float narrowed = static_cast<float>(value);
+        if (static_cast<double>(narrowed) == value || value != value) {
+            write_float32(narrowed);
+            return;
+        }
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        output_.push_back(static_cast<char>(0xcb));
+        write_big_endian(bits, 8);
+    }
+
+    static size_t container_header(char* header, uint32_t count, bool isObject) {
+        if (count < 16) {
+            header[0] = static_cast<char>((isObject ? 0x80 : 0x90) | count);
+            return 1;
+        }
+        if (count <= UINT16_MAX) {
+            header[0] = static_cast<char>(isObject ? 0xde : 0xdc);
+            store_big_endian(header + 1, count, 2);
+            return 3;
+        }
+        header[0] = static_cast<char>(isObject ? 0xdf : 0xdd);
+        store_big_endian(header + 1, count, 4);
+        return 5;
+    }
+
+    void write_string(const char* data, size_t length) {
+        if (length < 32) {
+            output_.push_back(static_cast<char>(0xa0 | length));
+        } else if (length <= UINT8_MAX) {
+            output_.push_back(static_cast<char>(0xd9));
+            write_big_endian(length, 1);
+        } else if (length <= UINT16_MAX) {
+            output_.push_back(static_cast<char>(0xda));
+            write_big_endian(length, 2);
+        } else {
+            output_.push_back(static_cast<char>(0xdb));
+            write_big_endian(length, 4);
+        }
+        output_.append(data, length);
+    }
+
+    void write_float32(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        output_.push_back(static_cast<char>(0xca));
+        write_big_endian(bits, 4);
+    }
+
+    void write_big_endian(uint64_t value, size_t bytes) {
+        char buffer[8];
+        store_big_endian(buffer, value, bytes);
+        output_.append(buffer, bytes);
+    }
+
+    static void store_big_endian(char* buffer, uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            buffer[i] = static_cast<char>((value >> (8 * (bytes - 1 - i))) & 0xFF);
+        }
+    }
+
+    StdString& output_;
+    StdVector<Frame> frames_;
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATION_WRITER_H
@@ -0,0 +1,28 @@
+#ifndef SIMD_SUPPORT_H
+#define SIMD_SUPPORT_H
+
+// Define as 1 to always use the portable scanners (e.g. to compare against the SIMD kernels)
+#ifndef NAYAN_SERIALIZER_DISABLE_SIMD
+#define NAYAN_SERIALIZER_DISABLE_SIMD 0
+#endif
+
+#if !NAYAN_SERIALIZER_DISABLE_SIMD && (defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)))
+#define NAYAN_SERIALIZER_SIMD_X86 1
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NAYAN_SERIALIZER_SIMD_AVX2)
+// AVX2 is compiled per function and chosen at run time, so the library still runs on older CPUs
+#define NAYAN_SERIALIZER_SIMD_AVX2 1
+#endif
+#if defined(NAYAN_SERIALIZER_SIMD_AVX2) && NAYAN_SERIALIZER_SIMD_AVX2
+#include <immintrin.h>
+#define NAYAN_SERIALIZER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define NAYAN_SERIALIZER_SIMD_X86 0
+#endif
+
+#ifndef NAYAN_SERIALIZER_SIMD_AVX2
+#define NAYAN_SERIALIZER_SIMD_AVX2 0
+#endif
+
+#endif // SIMD_SUPPORT_H
@@ -0,0 +1,218 @@
+#ifndef STRING_SCANNER_H
+#define STRING_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SimdSupport.h"
+
+namespace nayan {
+namespace serializer {
+
+/**
+ * Finds the characters that end a plain run of JSON string content, 16 or 32 bytes at a time
+ * (AVX2 or SSE2 when the CPU has them, a portable loop otherwise).
+ *
+ * JsonWriter copies everything before the first character that must be escaped with one append,
+ * and JsonReader returns or copies everything before the first quote or backslash, so strings
+ * without special characters are never handled byte by byte.
+ */
+class StringScanner {
+public:
+    /**
+     * Offset of the first character that JSON output must escape (quote, backslash or a control
+     * character below 0x20), or `length` when there is none.
+     */
+    static size_t FindEscapeCharacter(const char* data, size_t length) {
+        if (length < ShortLength) {
+            return find_escape_scalar(data, length);
+        }
+        return kernels().findEscape(data, length);
+    }
+
+    /**
+     * Offset of the first quote or backslash, or `length` when there is none.
+     */
+    static size_t FindQuoteOrBackslash(const char* data, size_t length) {
+        if (length < ShortLength) {
+            return find_quote_scalar(data, length);
+        }
+        return kernels().findQuote(data, length);
+    }
+
+    /**
+     * Name of the kernels used on this machine: "avx2", "sse2" or "scalar".
+     */
+    static const char* Backend() {
+        return kernels().name;
+    }
+
+private:
+    // Below one vector the call through the kernel table costs more than it saves
+    static constexpr size_t ShortLength = 16;
+
+    typedef size_t (*ScanFunction)(const char* data, size_t length);
+
+    struct Kernels {
+        ScanFunction findEscape;
+        ScanFunction findQuote;
+        const char* name;
+    };
+
+    // Kernel selection happens once per process
+    static const Kernels& kernels() {
+        static const Kernels selected = select_kernels();
+        return selected;
+    }
+
+    static Kernels select_kernels() {
+#if NAYAN_SERIALIZER_SIMD_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            return Kernels{&find_escape_avx2, &find_quote_avx2, "avx2"};
+        }
+#endif
+#if NAYAN_SERIALIZER_SIMD_X86
+        return Kernels{&find_escape_sse2, &find_quote_sse2, "sse2"};
+#else
+        return Kernels{&find_escape_scalar, &find_quote_scalar, "scalar"};
+#endif
+    }
+
+    static size_t find_escape_scalar(const char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c < 0x20 || c == '"' || c == '\\') {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    static size_t find_quote_scalar(const char* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            if (data[i] == '"' || data[i] == '\\') {
+                return i;
+            }
+        }
+        return length;
+    }
+
+#if NAYAN_SERIALIZER_SIMD_X86
+    // Bytes <= 0x1F compare equal to their unsigned maximum with 0x1F
+    static uint32_t escape_mask_sse2(const char* data) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i control = _mm_set1_epi8(0x1F);
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        return static_cast<uint32_t>(_mm_movemask_epi8(special));
+    }
+
+    static uint32_t quote_mask_sse2(const char* data) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+        return static_cast<uint32_t>(_mm_movemask_epi8(special));
+    }
+
+    static size_t find_escape_sse2(const char* data, size_t length) {
+        if (length < 16) {
+            return find_escape_scalar(data, length);
+        }
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            uint32_t bits = escape_mask_sse2(data + i);
+            if (bits != 0) {
+                return i + count_trailing_zeros(bits);
+            }
+        }
+        return i < length ? tail_offset(length - 16, escape_mask_sse2(data + length - 16), length) : length;
+    }
+
+    static size_t find_quote_sse2(const char* data, size_t length) {
+        if (length < 16) {
+            return find_quote_scalar(data, length);
+        }
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            uint32_t bits = quote_mask_sse2(data + i);
+            if (bits != 0) {
+                return i + count_trailing_zeros(bits);
+            }
+        }
+        return i < length ? tail_offset(length - 16, quote_mask_sse2(data + length - 16), length) : length;
+    }
+#endif
+
+#if NAYAN_SERIALIZER_SIMD_AVX2
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static uint32_t escape_mask_avx2(const char* data) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i control = _mm256_set1_epi8(0x1F);
+        __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    }
+
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static uint32_t quote_mask_avx2(const char* data) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    }
+
+    // Runs shorter than one AVX2 vector are left to the SSE2 kernel
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static size_t find_escape_avx2(const char* data, size_t length) {
+        if (length < 32) {
+            return find_escape_sse2(data, length);
+        }
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            uint32_t bits = escape_mask_avx2(data + i);
+            if (bits != 0) {
+                return i + count_trailing_zeros(bits);
+            }
+        }
+        return i < length ? tail_offset(length - 32, escape_mask_avx2(data + length - 32), length) : length;
+    }
+
+    NAYAN_SERIALIZER_TARGET_AVX2
+    static size_t find_quote_avx2(const char* data, size_t length) {
+        if (length < 32) {
+            return find_quote_sse2(data, length);
+        }
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            uint32_t bits = quote_mask_avx2(data + i);
+            if (bits != 0) {
+                return i + count_trailing_zeros(bits);
+            }
+        }
+        return i < length ? tail_offset(length - 32, quote_mask_avx2(data + length - 32), length) : length;
+    }
+#endif
+
+    // The tail is checked with one more vector ending at the last byte; it overlaps bytes already
+    // known to be plain, so the first bit set is still the first special character
+    static size_t tail_offset(size_t base, uint32_t bits, size_t length) {
+        return bits != 0 ? base + count_trailing_zeros(bits) : length;
+    }
+
+    static size_t count_trailing_zeros(uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctz(bits));
+#else
+        size_t count = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+};
+
+} // namespace serializer
+} // namespace nayan
+
+#endif // STRING_SCANNER_H
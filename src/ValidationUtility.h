@@ -10,40 +10,101 @@
 #include <deque>
 #include <array>
 #include <type_traits>
+#include <utility>
 
 namespace nayan {
 namespace validation {
 
+/**
+ * Non-allocating validation result.
+ * Used instead of a StdString error message by the non-throwing TryFromJson path:
+ * it only records the first failing field (a static string from generated code).
+ */
+struct ValidationStatus {
+    const char* field = nullptr;
+
+    bool empty() const {
+        return field == nullptr;
+    }
+};
+
 /**
  * Utility class for DTO validation.
  * Provides static methods for validating NotNull and NotBlank constraints.
  * Uses generic document type to support different JSON/document implementations.
+ * The document may also be a read-only view (JsonVariantConst, JsonObjectConst) into a
+ * larger document, which lets nested objects be validated in place without copying.
  */
 class ValidationUtility {
 public:
+    /**
+     * Record a validation error as a readable message.
+     * Produces "<Macro> field '<name><message>", separated from previous errors by ",\n".
+     */
+    static void ReportError(StdString& validationErrors, const char* macroName, const char* fieldName, const char* message) {
+        if (!validationErrors.empty()) validationErrors += ",\n";
+        validationErrors += macroName;
+        validationErrors += " field '";
+        validationErrors += fieldName;
+        validationErrors += message;
+    }
+
+    /**
+     * Record a validation error without allocating: only the first failing field is kept.
+     */
+    static void ReportError(ValidationStatus& validationErrors, const char* macroName, const char* fieldName, const char* message) {
+        (void)macroName;
+        (void)message;
+        if (validationErrors.field == nullptr) {
+            validationErrors.field = fieldName;
+        }
+    }
+
+    /**
+     * Record the errors of a nested object under its parent field.
+     */
+    static void ReportNestedErrors(StdString& validationErrors, const char* fieldName, const StdString& nestedErrors) {
+        if (nestedErrors.empty()) {
+            return;
+        }
+        if (!validationErrors.empty()) validationErrors += ",\n";
+        validationErrors += "Validation errors in nested object '";
+        validationErrors += fieldName;
+        validationErrors += "': ";
+        validationErrors += nestedErrors;
+    }
+
+    /**
+     * Record the first failing field of a nested object without allocating.
+     */
+    static void ReportNestedErrors(ValidationStatus& validationErrors, const char* fieldName, const ValidationStatus& nestedErrors) {
+        (void)fieldName;
+        if (validationErrors.field == nullptr) {
+            validationErrors.field = nestedErrors.field;
+        }
+    }
+
     /**
      * Validate that a field is not null in the document.
      * 
      * @tparam DocType The document type (e.g., JsonDocument, or future document types)
+     * @tparam ErrorSink StdString (readable messages) or ValidationStatus (first failing field only)
      * @tparam Args Optional variadic arguments for future extensibility
-     * @param doc The document (generic type, currently JsonDocument)
+     * @param doc The document (generic type, currently JsonDocument or a JsonVariantConst view)
      * @param fieldName The name of the field to validate
-     * @param validationErrors String to append error messages to (if validation fails)
+     * @param validationErrors StdString to append error messages to, or ValidationStatus (if validation fails)
      * @param args Optional variadic arguments for future extensibility
      * @return true if validation passes, false if validation fails
      */
-    template<typename DocType, typename... Args>
-    static bool ValidateNotNull(DocType& doc, const char* fieldName, StdString& validationErrors, Args... args) {
+    template<typename DocType, typename ErrorSink, typename... Args>
+    static bool ValidateNotNull(DocType& doc, const char* fieldName, ErrorSink& validationErrors, Args... args) {
         // Variadic args are available for future use but currently ignored
         (void)(sizeof...(args)); // Suppress unused parameter warning
         
         // For now, assume DocType has JsonDocument-like interface (isNull(), operator[])
         // In future, this can be specialized for different document types
         if (doc[fieldName].isNull()) {
-            if (!validationErrors.empty()) validationErrors += ",\n";
-            validationErrors += "NotNull field '";
-            validationErrors += fieldName;
-            validationErrors += "' is required but was null or missing";
+            ReportError(validationErrors, "NotNull", fieldName, "' is required but was null or missing");
             return false;
         }
         return true;
@@ -54,15 +115,16 @@ public:
      * Also validates that the field is not null.
      * 
      * @tparam DocType The document type (e.g., JsonDocument, or future document types)
+     * @tparam ErrorSink StdString (readable messages) or ValidationStatus (first failing field only)
      * @tparam Args Optional variadic arguments for future extensibility
-     * @param doc The document (generic type, currently JsonDocument)
+     * @param doc The document (generic type, currently JsonDocument or a JsonVariantConst view)
      * @param fieldName The name of the field to validate
-     * @param validationErrors String to append error messages to (if validation fails)
+     * @param validationErrors StdString to append error messages to, or ValidationStatus (if validation fails)
      * @param args Optional variadic arguments for future extensibility
      * @return true if validation passes, false if validation fails
      */
-    template<typename DocType, typename... Args>
-    static bool ValidateNotBlank(DocType& doc, const char* fieldName, StdString& validationErrors, Args... args) {
+    template<typename DocType, typename ErrorSink, typename... Args>
+    static bool ValidateNotBlank(DocType& doc, const char* fieldName, ErrorSink& validationErrors, Args... args) {
         // Variadic args are available for future use but currently ignored
         (void)(sizeof...(args)); // Suppress unused parameter warning
         
@@ -70,43 +132,23 @@ public:
         // In future, this can be specialized for different document types
         // First check if field is null
         if (doc[fieldName].isNull()) {
-            if (!validationErrors.empty()) validationErrors += ",\n";
-            validationErrors += "NotBlank field '";
-            validationErrors += fieldName;
-            validationErrors += "' is required but was null or missing";
+            ReportError(validationErrors, "NotBlank", fieldName, "' is required but was null or missing");
             return false;
         }
         
-        // Get the string value
-        StdString fieldValue = doc[fieldName].template as<const char*>();
-        
-        // Trim whitespace (spaces, tabs, newlines, carriage returns)
-        StdString trimmed = fieldValue;
-        // Trim leading whitespace
-        size_t start = trimmed.find_first_not_of(" \t\n\r");
-        if (start != StdString::npos) {
-            trimmed.erase(0, start);
-        } else {
-            // String contains only whitespace
-            trimmed.clear();
-        }
-        
-        // Trim trailing whitespace
-        if (!trimmed.empty()) {
-            size_t end = trimmed.find_last_not_of(" \t\n\r");
-            if (end != StdString::npos) {
-                trimmed.erase(end + 1);
-            } else {
-                trimmed.clear();
+        // Scan the string value in place for a non-whitespace character (no copy)
+        const char* fieldValue = doc[fieldName].template as<const char*>();
+        bool hasContent = false;
+        for (const char* c = fieldValue; c != nullptr && *c != '\0'; ++c) {
+            if (*c != ' ' && *c != '\t' && *c != '\n' && *c != '\r') {
+                hasContent = true;
+                break;
             }
         }
         
-        // Check if trimmed string is empty
-        if (trimmed.empty()) {
-            if (!validationErrors.empty()) validationErrors += ",\n";
-            validationErrors += "NotBlank field '";
-            validationErrors += fieldName;
-            validationErrors += "' cannot be empty or blank";
+        // Check if the string is empty or whitespace only
+        if (!hasContent) {
+            ReportError(validationErrors, "NotBlank", fieldName, "' cannot be empty or blank");
             return false;
         }
         
@@ -120,15 +162,16 @@ public:
      * Also validates that the field is not null.
      * 
      * @tparam DocType The document type (e.g., JsonDocument, or future document types)
+     * @tparam ErrorSink StdString (readable messages) or ValidationStatus (first failing field only)
      * @tparam Args Optional variadic arguments for future extensibility (e.g., type hint)
-     * @param doc The document (generic type, currently JsonDocument)
+     * @param doc The document (generic type, currently JsonDocument or a JsonVariantConst view)
      * @param fieldName The name of the field to validate
-     * @param validationErrors String to append error messages to (if validation fails)
+     * @param validationErrors StdString to append error messages to, or ValidationStatus (if validation fails)
      * @param args Optional variadic arguments for future extensibility
      * @return true if validation passes, false if validation fails
      */
-    template<typename DocType, typename... Args>
-    static bool ValidateNotEmpty(DocType& doc, const char* fieldName, StdString& validationErrors, Args... args) {
+    template<typename DocType, typename ErrorSink, typename... Args>
+    static bool ValidateNotEmpty(DocType& doc, const char* fieldName, ErrorSink& validationErrors, Args... args) {
         // Variadic args are available for future use but currently ignored
         (void)(sizeof...(args)); // Suppress unused parameter warning
         
@@ -137,47 +180,35 @@ public:
         
         // First check if field is null
         if (doc[fieldName].isNull()) {
-            if (!validationErrors.empty()) validationErrors += ",\n";
-            validationErrors += "NotEmpty field '";
-            validationErrors += fieldName;
-            validationErrors += "' is required but was null or missing";
+            ReportError(validationErrors, "NotEmpty", fieldName, "' is required but was null or missing");
             return false;
         }
         
         // Check if it's a string
         if (doc[fieldName].template is<const char*>() || doc[fieldName].template is<StdString>()) {
-            StdString fieldValue = doc[fieldName].template as<const char*>();
-            if (fieldValue.empty()) {
-                if (!validationErrors.empty()) validationErrors += ",\n";
-                validationErrors += "NotEmpty field '";
-                validationErrors += fieldName;
-                validationErrors += "' cannot be empty";
+            const char* fieldValue = doc[fieldName].template as<const char*>();
+            if (fieldValue == nullptr || *fieldValue == '\0') {
+                ReportError(validationErrors, "NotEmpty", fieldName, "' cannot be empty");
                 return false;
             }
             return true;
         }
         
         // Check if it's a JSON array (vector, list, set, deque, array, or C-style array)
-        if (doc[fieldName].template is<JsonArray>()) {
-            JsonArray arr = doc[fieldName].template as<JsonArray>();
+        if (doc[fieldName].template is<JsonArrayConst>()) {
+            JsonArrayConst arr = doc[fieldName].template as<JsonArrayConst>();
             if (arr.size() == 0) {
-                if (!validationErrors.empty()) validationErrors += ",\n";
-                validationErrors += "NotEmpty field '";
-                validationErrors += fieldName;
-                validationErrors += "' (array/collection) cannot be empty";
+                ReportError(validationErrors, "NotEmpty", fieldName, "' (array/collection) cannot be empty");
                 return false;
             }
             return true;
         }
         
         // Check if it's a JSON object (map)
-        if (doc[fieldName].template is<JsonObject>()) {
-            JsonObject obj = doc[fieldName].template as<JsonObject>();
+        if (doc[fieldName].template is<JsonObjectConst>()) {
+            JsonObjectConst obj = doc[fieldName].template as<JsonObjectConst>();
             if (obj.size() == 0) {
-                if (!validationErrors.empty()) validationErrors += ",\n";
-                validationErrors += "NotEmpty field '";
-                validationErrors += fieldName;
-                validationErrors += "' (map) cannot be empty";
+                ReportError(validationErrors, "NotEmpty", fieldName, "' (map) cannot be empty");
                 return false;
             }
             return true;
@@ -190,6 +221,100 @@ public:
         
         return true;
     }
+
+    /**
+     * Validate that a deserialized field holds a value.
+     * Object-level counterpart of ValidateNotNull, used by the generated pull parsers (ReadFrom,
+     * DecodeBinary) that fill the object without a document.
+     * 
+     * @tparam T The optional field type
+     * @tparam ErrorSink StdString (readable messages) or ValidationStatus (first failing field only)
+     * @param value The field value
+     * @param fieldName The name of the field to validate
+     * @param validationErrors StdString to append error messages to, or ValidationStatus (if validation fails)
+     * @return true if validation passes, false if validation fails
+     */
+    template<typename T, typename ErrorSink>
+    static bool ValidateNotNullValue(const T& value, const char* fieldName, ErrorSink& validationErrors) {
+        if (!value.has_value()) {
+            ReportError(validationErrors, "NotNull", fieldName, "' is required but was null or missing");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Validate that a deserialized string field is present and not blank (same rules as ValidateNotBlank).
+     * Non-string values fail, as they do in the document check.
+     */
+    template<typename T, typename ErrorSink>
+    static bool ValidateNotBlankValue(const T& value, const char* fieldName, ErrorSink& validationErrors) {
+        if (!value.has_value()) {
+            ReportError(validationErrors, "NotBlank", fieldName, "' is required but was null or missing");
+            return false;
+        }
+        
+        bool hasContent = false;
+        using ValueType = typename T::value_type;
+        if constexpr (std::is_same_v<ValueType, StdString>) {
+            for (char c : value.value()) {
+                if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                    hasContent = true;
+                    break;
+                }
+            }
+        }
+        
+        if (!hasContent) {
+            ReportError(validationErrors, "NotBlank", fieldName, "' cannot be empty or blank");
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Validate that a deserialized string, collection or map field is present and not empty
+     * (same rules as ValidateNotEmpty). Other types only need to be present.
+     */
+    template<typename T, typename ErrorSink>
+    static bool ValidateNotEmptyValue(const T& value, const char* fieldName, ErrorSink& validationErrors) {
+        if (!value.has_value()) {
+            ReportError(validationErrors, "NotEmpty", fieldName, "' is required but was null or missing");
+            return false;
+        }
+        
+        using ValueType = typename T::value_type;
+        if constexpr (std::is_same_v<ValueType, StdString>) {
+            if (value.value().empty()) {
+                ReportError(validationErrors, "NotEmpty", fieldName, "' cannot be empty");
+                return false;
+            }
+        } else if constexpr (has_mapped_type<ValueType>::value) {
+            if (value.value().empty()) {
+                ReportError(validationErrors, "NotEmpty", fieldName, "' (map) cannot be empty");
+                return false;
+            }
+        } else if constexpr (has_empty<ValueType>::value) {
+            if (value.value().empty()) {
+                ReportError(validationErrors, "NotEmpty", fieldName, "' (array/collection) cannot be empty");
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    template<typename T, typename = void>
+    struct has_mapped_type : std::false_type {};
+
+    template<typename T>
+    struct has_mapped_type<T, std::void_t<typename T::mapped_type>> : std::true_type {};
+
+    template<typename T, typename = void>
+    struct has_empty : std::false_type {};
+
+    template<typename T>
+    struct has_empty<T, std::void_t<decltype(std::declval<const T&>().empty())>> : std::true_type {};
 };
 
 } // namespace validation
@@ -0,0 +1,107 @@
+// ArenaAllocator: bump allocation inside the buffer, in-place growth of the last block,
+// exhaustion reported as nullptr / NoMemory, and Reset().
+
+#include <ArenaAllocator.h>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static bool inside(const void* pointer, size_t size, const unsigned char* buffer, size_t capacity) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(pointer);
+    return bytes >= buffer && bytes + size <= buffer + capacity;
+}
+
+static void allocations_stay_inside_the_buffer() {
+    alignas(std::max_align_t) unsigned char buffer[256];
+    // Capacities that are not a multiple of the alignment, and a misaligned start
+    for (size_t offset : {size_t(0), size_t(1), size_t(3)}) {
+        for (size_t capacity : {size_t(0), size_t(7), size_t(90), size_t(129), size_t(200)}) {
+            ArenaAllocator arena(buffer + offset, capacity);
+            CHECK(arena.Capacity() <= capacity);
+            for (size_t size : {size_t(70), size_t(1), size_t(1000), size_t(0), size_t(13)}) {
+                void* pointer = arena.allocate(size);
+                CHECK(pointer == nullptr || inside(pointer, size, buffer + offset, capacity));
+                CHECK(pointer == nullptr || reinterpret_cast<uintptr_t>(pointer) % alignof(std::max_align_t) == 0);
+                CHECK(arena.Used() <= arena.Capacity());
+            }
+        }
+    }
+
+    // The allocation that used to end past the buffer
+    ArenaAllocator arena(buffer, 90);
+    CHECK(arena.allocate(70) != nullptr);
+    CHECK(arena.allocate(1000) == nullptr);
+    CHECK(arena.allocate(1) == nullptr);
+    CHECK(arena.Used() == 90);
+}
+
+static void reallocate_grows_the_last_block_in_place() {
+    StaticArenaAllocator<512> arena;
+    char* first = static_cast<char*>(arena.allocate(16));
+    std::memcpy(first, "0123456789abcdef", 16);
+    char* grown = static_cast<char*>(arena.reallocate(first, 64));
+    CHECK(grown == first);
+
+    // An older block is copied when it grows
+    void* second = arena.allocate(8);
+    CHECK(second != nullptr);
+    char* moved = static_cast<char*>(arena.reallocate(grown, 128));
+    CHECK(moved != nullptr && moved != grown);
+    CHECK(moved != nullptr && std::memcmp(moved, "0123456789abcdef", 16) == 0);
+
+    // Growing past the end fails and leaves the arena usable
+    CHECK(arena.reallocate(moved, 4096) == nullptr);
+    CHECK(arena.allocate(8) != nullptr);
+}
+
+static void exhaustion_and_reset() {
+    StaticArenaAllocator<1024> arena;
+    size_t count = 0;
+    while (arena.allocate(40) != nullptr) {
+        ++count;
+    }
+    CHECK(count > 0);
+    CHECK(arena.Used() <= arena.Capacity());
+
+    // Reset makes the whole capacity available again, from the same address
+    arena.Reset();
+    CHECK(arena.Used() == 0);
+    size_t again = 0;
+    while (arena.allocate(40) != nullptr) {
+        ++again;
+    }
+    CHECK(again == count);
+}
+
+static void documents_report_no_memory() {
+    Project project = MakeProject(20);
+    StdString json = ToJson(project);
+
+    // Too small for the document: the parse fails instead of writing past the buffer
+    StaticArenaAllocator<600> small;
+    {
+        JsonDocument doc(&small);
+        CHECK(deserializeJson(doc, json) == DeserializationError::NoMemory);
+    }
+    CHECK(small.Used() <= small.Capacity());
+
+    StaticArenaAllocator<1 << 16> arena;
+    SerializationContext context(&arena);
+    for (int round = 0; round < 3; ++round) {
+        optional<Project> back = SerializationUtility::Deserialize<optional<Project>>(json, context);
+        CHECK(back.has_value() && ToJson(*back) == json);
+        CHECK(arena.Used() > 0);
+        arena.Reset();
+        CHECK(arena.Used() == 0);
+    }
+}
+
+int main() {
+    RUN_TEST(allocations_stay_inside_the_buffer);
+    RUN_TEST(reallocate_grows_the_last_block_in_place);
+    RUN_TEST(exhaustion_and_reset);
+    RUN_TEST(documents_report_no_memory);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,174 @@
+// Base64 against a reference encoder, and Base64Bytes/Base64Array fields through JSON, MessagePack
+// and the binary codec. Built twice: with the SIMD kernels and with NAYAN_SERIALIZER_DISABLE_SIMD.
+
+#include <cctype>
+#include <vector>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static StdString reference_encode(const std::vector<uint8_t>& data) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    StdString out;
+    size_t i = 0;
+    for (; i + 3 <= data.size(); i += 3) {
+        uint32_t triple = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+        out += alphabet[(triple >> 18) & 63];
+        out += alphabet[(triple >> 12) & 63];
+        out += alphabet[(triple >> 6) & 63];
+        out += alphabet[triple & 63];
+    }
+    if (i < data.size()) {
+        uint32_t triple = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < data.size()) {
+            triple |= static_cast<uint32_t>(data[i + 1]) << 8;
+        }
+        out += alphabet[(triple >> 18) & 63];
+        out += alphabet[(triple >> 12) & 63];
+        out += i + 1 < data.size() ? alphabet[(triple >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+// Every character in the alphabet, '=' only as the last one or two
+static bool reference_valid(const StdString& text) {
+    size_t length = text.size();
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '=') {
+            if (!(i == length - 1 || (i == length - 2 && text[length - 1] == '='))) {
+                return false;
+            }
+        } else if (!((c < 128 && std::isalnum(c)) || c == '+' || c == '/')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void matches_reference_encoder() {
+    Random random(5);
+    const char corruptions[] = {'=', '-', '_', ' ', '\n', '\x80', '*', '.'};
+    for (int iteration = 0; iteration < 50000; ++iteration) {
+        std::vector<uint8_t> data(random.Below(300));
+        for (uint8_t& byte : data) {
+            byte = static_cast<uint8_t>(random.Next());
+        }
+        StdString expected = reference_encode(data);
+        CHECK(Base64::EncodedLength(data.size()) == expected.size());
+        // Exact-size buffers, so a sanitizer build catches writes past the end
+        std::vector<char> encoded(expected.size());
+        Base64::Encode(data.data(), data.size(), encoded.data());
+        CHECK(StdString(encoded.data(), encoded.size()) == expected);
+
+        StdString text = expected;
+        bool corrupt = !text.empty() && random.Below(3) == 0;
+        if (corrupt) {
+            text[random.Below(text.size())] = corruptions[random.Below(sizeof(corruptions))];
+        }
+        std::vector<uint8_t> decoded(Base64::DecodedCapacity(text.size()));
+        size_t written = 0;
+        bool ok = Base64::Decode(text.data(), text.size(), decoded.data(), written);
+        CHECK(ok == reference_valid(text));
+        if (!corrupt) {
+            CHECK(ok && written == data.size() && std::equal(data.begin(), data.end(), decoded.begin()));
+        }
+    }
+}
+
+static void rejects_malformed_text() {
+    const char* invalid[] = {"A", "AB", "ABC", "ABCDE", "A===", "=AAA", "AB=C", "AB*D", "AB D", "QUJD\n"};
+    for (const char* text : invalid) {
+        uint8_t decoded[8];
+        size_t written = 0;
+        CHECK(!Base64::Decode(text, std::strlen(text), decoded, written));
+    }
+}
+
+static void round_trips_fields_in_every_format() {
+    Task task = MakeTask(6);
+    CHECK(task.attachment.has_value() && task.checksum.has_value());
+    task.attachment = Base64Bytes{0xde, 0xad, 0xbe, 0xef, 0x00};
+    Base64Array<4> checksum;
+    checksum[0] = 1;
+    checksum[1] = 2;
+    checksum[2] = 3;
+    checksum[3] = 255;
+    task.checksum = checksum;
+
+    StdString json = ToJson(task);
+    CHECK(json.find("\"attachment\":\"3q2+7wA=\"") != StdString::npos);
+    CHECK(json.find("\"checksum\":\"AQID/w==\"") != StdString::npos);
+    CHECK(SerializationUtility::MeasureSerialized(task) == json.size());
+    Task fromJson;
+    CHECK(SerializationUtility::TryDeserialize(json, fromJson));
+    CHECK(*fromJson.attachment == *task.attachment && *fromJson.checksum == *task.checksum);
+
+    StdString msgpack;
+    MsgPackWriter msgpackWriter(msgpack);
+    task.WriteTo(msgpackWriter);
+    MsgPackReader msgpackReader(msgpack.data(), msgpack.size());
+    Task fromMsgPack;
+    CHECK(Task::ReadFrom(msgpackReader, fromMsgPack));
+    CHECK(*fromMsgPack.attachment == *task.attachment && *fromMsgPack.checksum == *task.checksum);
+
+    StdString binary = task.EncodeBinary();
+    Task fromBinary;
+    CHECK(BinaryCodec::Decode(binary, fromBinary));
+    CHECK(*fromBinary.attachment == *task.attachment && *fromBinary.checksum == *task.checksum);
+}
+
+static void round_trips_top_level_buffers() {
+    Base64Bytes bytes{0xde, 0xad, 0xbe, 0xef, 0x00};
+    StdString json = SerializationUtility::Serialize(bytes);
+    CHECK(json == "\"3q2+7wA=\"");
+    CHECK(SerializationUtility::Deserialize<Base64Bytes>(json) == bytes);
+    CHECK_THROWS(SerializationUtility::Deserialize<Base64Bytes>("\"%%%%\""));
+
+    StdVector<Base64Bytes> list{Base64Bytes{1}, Base64Bytes{}};
+    json = SerializationUtility::Serialize(list);
+    CHECK(json == "[\"AQ==\",\"\"]");
+    StdVector<Base64Bytes> listBack;
+    CHECK(SerializationUtility::TryDeserialize(json, listBack));
+    CHECK(listBack == list);
+
+    // Plain byte vectors stay numeric arrays
+    CHECK(SerializationUtility::Serialize(StdVector<UInt8>{1, 2}) == "[1,2]");
+
+    Base64Bytes large(100000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<UInt8>(i * 7);
+    }
+    Base64Bytes largeBack;
+    CHECK(SerializationUtility::TryDeserialize(SerializationUtility::Serialize(large), largeBack));
+    CHECK(largeBack == large);
+}
+
+static void reports_invalid_fields() {
+    const char* invalid[] = {
+        "{\"title\":\"t\",\"attachment\":\"3q2+7w=\"}",
+        "{\"title\":\"t\",\"attachment\":\"3q2*7wA=\"}",
+        "{\"title\":\"t\",\"attachment\":[1,2]}",
+        "{\"title\":\"t\",\"checksum\":\"AQIDBAU=\"}",
+        "{\"title\":\"t\",\"checksum\":\"AQI=\"}",
+    };
+    for (const char* json : invalid) {
+        Task task;
+        DeserializeStatus status = SerializationUtility::TryDeserialize(json, std::strlen(json), task);
+        CHECK(!status);
+        CHECK(status.field != nullptr);
+    }
+}
+
+int main() {
+    std::printf("base64: %s\n", Base64::Backend());
+    RUN_TEST(matches_reference_encoder);
+    RUN_TEST(rejects_malformed_text);
+    RUN_TEST(round_trips_fields_in_every_format);
+    RUN_TEST(round_trips_top_level_buffers);
+    RUN_TEST(reports_invalid_fields);
+    return nayan::serializer::test::Finish();
+}
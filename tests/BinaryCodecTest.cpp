@@ -0,0 +1,105 @@
+// BinaryCodec: round trips of values and generated EncodeBinary/DecodeBinary, unknown field ids
+// skipped by older readers, and truncated or malformed input rejected without reading past the end.
+
+#include "SampleData.h"
+#include "TaskSummary.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+template<typename T>
+static T round_trip(const T& value) {
+    T back{};
+    DeserializeStatus status = BinaryCodec::Decode(BinaryCodec::Encode(value), back);
+    CHECK(status);
+    return back;
+}
+
+static void round_trips_values() {
+    CHECK(round_trip(int64_t(-1)) == -1);
+    CHECK(round_trip(std::numeric_limits<int64_t>::min()) == std::numeric_limits<int64_t>::min());
+    CHECK(round_trip(std::numeric_limits<uint64_t>::max()) == std::numeric_limits<uint64_t>::max());
+    CHECK(round_trip(2.5) == 2.5 && round_trip(-0.25f) == -0.25f);
+    CHECK(round_trip(StdString("a\0b", 3)) == StdString("a\0b", 3));
+    StdVector<optional<int>> optionals{1, optional<int>(), -3};
+    CHECK(round_trip(optionals) == optionals);
+    StdMap<StdString, int> map{{"a", 1}, {"b", -2}};
+    CHECK(round_trip(map) == map);
+
+    // Small negative numbers stay short (zigzag)
+    CHECK(BinaryCodec::Encode(int32_t(-1)).size() == 1);
+    // Varints are little-endian groups of 7 bits
+    CHECK(BinaryCodec::Encode(uint32_t(300)) == StdString("\xac\x02"));
+}
+
+static void round_trips_objects() {
+    // Payloads longer than 127 and 16383 bytes widen their length prefix after the fact
+    for (size_t count : {size_t(0), size_t(1), size_t(5), size_t(300)}) {
+        Project project = MakeProject(count);
+        StdString encoded = project.EncodeBinary();
+        Project back;
+        CHECK(Project::DecodeBinary(encoded, back));
+        CHECK(ToJson(back) == ToJson(project));
+    }
+    Project empty;
+    CHECK(empty.EncodeBinary().empty());
+}
+
+static void skips_unknown_field_ids() {
+    Task task = MakeTask(6);
+    TaskSummary summary;
+    CHECK(TaskSummary::DecodeBinary(task.EncodeBinary(), summary));
+    CHECK(summary.title == task.title && summary.checkpoints == task.checkpoints);
+
+    // And the other way round: Task ignores nothing it knows, reads the two fields it shares
+    Task back;
+    CHECK(Task::DecodeBinary(summary.EncodeBinary(), back));
+    CHECK(back.title == task.title && back.checkpoints == task.checkpoints && !back.estimate.has_value());
+}
+
+static void rejects_truncated_input() {
+    uint64_t value = 0;
+    CHECK(BinaryCodec::Decode(StdString("\x80"), value).error == DeserializeError::IncompleteInput);
+    CHECK(BinaryCodec::Decode(StdString(""), value).error == DeserializeError::IncompleteInput);
+    // More than 10 bytes cannot be a varint
+    CHECK(BinaryCodec::Decode(StdString(11, '\x80') + "\x01", value).error == DeserializeError::InvalidInput);
+    uint8_t small = 0;
+    CHECK(BinaryCodec::Decode(BinaryCodec::Encode(uint32_t(256)), small).error == DeserializeError::OutOfRange);
+    StdString text;
+    CHECK(BinaryCodec::Decode(StdString("\x05" "abc"), text).error == DeserializeError::IncompleteInput);
+
+    // Every prefix either fails, or ends on a field boundary and decodes to exactly that prefix
+    // (unless the prefix lacks a required field)
+    StdString encoded = MakeProject(3).EncodeBinary();
+    for (size_t length = 0; length < encoded.size(); ++length) {
+        Project partial;
+        DeserializeStatus status = Project::DecodeBinary(encoded.substr(0, length), partial);
+        if (status) {
+            CHECK(partial.EncodeBinary() == encoded.substr(0, length));
+        } else {
+            CHECK(status.error == DeserializeError::IncompleteInput || status.error == DeserializeError::InvalidInput ||
+                  status.error == DeserializeError::ValidationFailed);
+            CHECK(status.offset <= length);
+        }
+    }
+}
+
+static void rejects_mismatched_wire_types() {
+    // Field 1 (title) sent as a varint
+    Task task;
+    DeserializeStatus status = Task::DecodeBinary(StdString("\x08\x01"), task);
+    CHECK(status.error == DeserializeError::TypeMismatch);
+    CHECK(status.field != nullptr && std::strcmp(status.field, "title") == 0);
+    // Wire types 3, 4, 6 and 7 are not used by the format and cannot be skipped
+    CHECK(Task::DecodeBinary(StdString("\xfb\x01"), task).error == DeserializeError::InvalidInput);
+}
+
+int main() {
+    RUN_TEST(round_trips_values);
+    RUN_TEST(round_trips_objects);
+    RUN_TEST(skips_unknown_field_ids);
+    RUN_TEST(rejects_truncated_input);
+    RUN_TEST(rejects_mismatched_wire_types);
+    return nayan::serializer::test::Finish();
+}
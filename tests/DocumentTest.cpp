@@ -0,0 +1,118 @@
+// The ArduinoJson document paths: generated SerializeTo, FromJson, TryFromJson and ValidateFields,
+// and DeserializeFrom/SerializeInto for containers, against the writer/reader output.
+
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static StdString document_json(const Project& project) {
+    JsonDocument doc;
+    project.SerializeTo(doc.to<JsonObject>());
+    StdString json;
+    serializeJson(doc, json);
+    return json;
+}
+
+static void serialize_to_matches_the_writer() {
+    for (size_t count : {size_t(0), size_t(1), size_t(7)}) {
+        Project project = MakeProject(count);
+        CHECK(document_json(project) == ToJson(project));
+    }
+    Project empty;
+    CHECK(document_json(empty) == ToJson(empty));
+}
+
+static void from_json_round_trips() {
+    Project project = MakeProject(9);
+    JsonDocument doc;
+    CHECK(!deserializeJson(doc, ToJson(project)));
+    CHECK(ToJson(Project::FromJson(doc.as<JsonVariantConst>())) == ToJson(project));
+
+    Project back;
+    CHECK(Project::TryFromJson(doc.as<JsonVariantConst>(), back));
+    CHECK(ToJson(back) == ToJson(project));
+
+    // Containers of DTOs go through the elements' FromJson
+    StdVector<Task> tasks = MakeTasks(20);
+    CHECK(!deserializeJson(doc, SerializationUtility::Serialize(tasks)));
+    CHECK(SerializationUtility::Serialize(SerializationUtility::DeserializeFrom<StdVector<Task>>(doc.as<JsonVariantConst>())) ==
+          SerializationUtility::Serialize(tasks));
+
+    // SerializeInto writes the same JSON as Serialize
+    JsonDocument out;
+    SerializationUtility::SerializeInto(tasks, out.to<JsonVariant>());
+    StdString json;
+    serializeJson(out, json);
+    CHECK(json == SerializationUtility::Serialize(tasks));
+}
+
+static void rejects_values_of_the_wrong_type() {
+    struct Case {
+        const char* json;
+        DeserializeError error;
+        const char* field;
+    };
+    const Case cases[] = {
+        {"5", DeserializeError::TypeMismatch, nullptr},
+        {"[]", DeserializeError::TypeMismatch, nullptr},
+        {"\"text\"", DeserializeError::TypeMismatch, nullptr},
+        {"{\"title\":\"t\",\"estimate\":true}", DeserializeError::TypeMismatch, "estimate"},
+        {"{\"title\":\"t\",\"estimate\":1.5}", DeserializeError::TypeMismatch, "estimate"},
+        {"{\"title\":\"t\",\"estimate\":99999999999}", DeserializeError::OutOfRange, "estimate"},
+        {"{\"title\":\"t\",\"estimate\":{}}", DeserializeError::TypeMismatch, "estimate"},
+        {"{\"title\":\"t\",\"checkpoints\":{}}", DeserializeError::TypeMismatch, "checkpoints"},
+        {"{\"title\":\"t\",\"priority\":5}", DeserializeError::TypeMismatch, "priority"},
+    };
+    for (const Case& c : cases) {
+        JsonDocument doc;
+        CHECK(!deserializeJson(doc, c.json));
+        Task task;
+        DeserializeStatus status = Task::TryFromJson(doc.as<JsonVariantConst>(), task);
+        CHECK(status.error == c.error);
+        CHECK(c.field == nullptr ? status.field == nullptr : status.field != nullptr && std::strcmp(status.field, c.field) == 0);
+        // The pull parser reports the same error
+        CHECK(SerializationUtility::TryDeserialize(StdString(c.json), task).error == c.error);
+        CHECK_THROWS(Task::FromJson(doc.as<JsonVariantConst>()));
+    }
+
+    // Strings accept numbers and booleans as their text, as in ReadFrom, but not objects or arrays
+    JsonDocument doc;
+    CHECK(!deserializeJson(doc, "{\"name\":5,\"active\":true,\"lead\":{\"title\":\"t\"}}"));
+    Project project = Project::FromJson(doc.as<JsonVariantConst>());
+    CHECK(project.name == StdString("5") && project.active == true);
+    CHECK(!deserializeJson(doc, "{\"name\":{},\"lead\":{\"title\":\"t\"}}"));
+    CHECK_THROWS(Project::FromJson(doc.as<JsonVariantConst>()));
+    Project ignored;
+    CHECK(Project::TryFromJson(doc.as<JsonVariantConst>(), ignored).error == DeserializeError::TypeMismatch);
+}
+
+static void validates_fields_on_the_document() {
+    JsonDocument doc;
+    CHECK(!deserializeJson(doc, "{\"lead\":{\"title\":\"t\"}}"));
+    CHECK(!Project::ValidateFields(doc).empty());
+    CHECK(!deserializeJson(doc, "{\"name\":\"n\",\"lead\":{\"title\":\"  \"}}"));
+    JsonVariantConst lead = doc["lead"];
+    CHECK(!Task::ValidateFields(lead).empty());
+    Project project;
+    DeserializeStatus status = Project::TryFromJson(doc.as<JsonVariantConst>(), project);
+    CHECK(status.error == DeserializeError::ValidationFailed);
+    // The innermost failing field is reported, as by TryDeserialize
+    CHECK(status.field != nullptr && std::strcmp(status.field, "title") == 0);
+    DeserializeStatus pulled = SerializationUtility::TryDeserialize(StdString("{\"name\":\"n\",\"lead\":{\"title\":\"  \"}}"), project);
+    CHECK(pulled.error == DeserializeError::ValidationFailed);
+    CHECK(pulled.field != nullptr && std::strcmp(pulled.field, status.field) == 0);
+    CHECK_THROWS(Project::FromJson(doc.as<JsonVariantConst>()));
+
+    CHECK(!deserializeJson(doc, ToJson(MakeProject(2))));
+    CHECK(Project::ValidateFields(doc).empty());
+}
+
+int main() {
+    RUN_TEST(serialize_to_matches_the_writer);
+    RUN_TEST(from_json_round_trips);
+    RUN_TEST(rejects_values_of_the_wrong_type);
+    RUN_TEST(validates_fields_on_the_document);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,127 @@
+// Enum names on every deserialization path: known names case-insensitively, unknown names as the
+// first enumerator by default and as an error everywhere with NAYAN_SERIALIZER_STRICT_ENUMS=1
+// (built twice, see CMakeLists.txt).
+
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static const char* const TaskJson = "{\"title\":\"t\",\"priority\":\"%s\"}";
+
+static StdString task_json(const char* priority) {
+    char json[64];
+    std::snprintf(json, sizeof(json), TaskJson, priority);
+    return json;
+}
+
+// Every path that reads a Priority, with the outcome it reported
+struct Outcomes {
+    StdVector<DeserializeError> errors;  // Non-throwing paths
+    StdVector<Priority> values;          // Values read by the paths that succeeded
+    size_t throws = 0;                   // Throwing paths that threw
+};
+
+static Outcomes read_everywhere(const char* name) {
+    Outcomes outcomes;
+    StdString quoted = StdString("\"") + name + "\"";
+    StdString json = task_json(name);
+    auto record = [&](DeserializeStatus status, const optional<Priority>& value) {
+        outcomes.errors.push_back(status.error);
+        if (status) {
+            outcomes.values.push_back(value.value_or(Priority::Normal));
+        }
+    };
+    auto attempt = [&](auto read) {
+        try {
+            outcomes.values.push_back(read());
+        } catch (const std::exception&) {
+            ++outcomes.throws;
+        }
+    };
+
+    // Standalone values
+    Priority priority = Priority::Normal;
+    DeserializeStatus status = SerializationUtility::TryDeserialize(quoted, priority);
+    record(status, priority);
+    attempt([&] { return SerializationUtility::Deserialize<Priority>(quoted); });
+
+    // Pull parser (ReadFrom), throwing and not
+    Task task;
+    status = SerializationUtility::TryDeserialize(json, task);
+    record(status, task.priority);
+    attempt([&] { return *Task::Deserialize(json).priority; });
+
+    // Document paths (FromJson, TryFromJson, DeserializeFrom)
+    JsonDocument doc;
+    CHECK(!deserializeJson(doc, json));
+    Task fromDocument;
+    status = Task::TryFromJson(doc.as<JsonVariantConst>(), fromDocument);
+    record(status, fromDocument.priority);
+    attempt([&] { return *Task::FromJson(doc.as<JsonVariantConst>()).priority; });
+    attempt([&] { return SerializationUtility::DeserializeFrom<Priority>(doc["priority"]); });
+
+    // MessagePack
+    StdString msgpack = SerializationUtility::SerializeMsgPack(StdVector<StdString>{name});
+    StdVector<Priority> priorities;
+    status = SerializationUtility::TryDeserializeMsgPack(msgpack, priorities);
+    record(status, priorities.empty() ? optional<Priority>() : optional<Priority>(priorities[0]));
+
+    // Containers
+    attempt([&] { return SerializationUtility::Deserialize<StdVector<Priority>>("[" + quoted + "]").at(0); });
+    return outcomes;
+}
+
+static void reads_known_names_case_insensitively() {
+    for (const char* name : {"Urgent", "urgent", "URGENT"}) {
+        Outcomes outcomes = read_everywhere(name);
+        CHECK(outcomes.throws == 0);
+        for (DeserializeError error : outcomes.errors) {
+            CHECK(error == DeserializeError::Ok);
+        }
+        CHECK(outcomes.values.size() == 9);
+        for (Priority value : outcomes.values) {
+            CHECK(value == Priority::Urgent);
+        }
+    }
+}
+
+static void treats_unknown_names_the_same_on_every_path() {
+    for (const char* name : {"Someday", "", "Urgent "}) {
+        Outcomes outcomes = read_everywhere(name);
+#if NAYAN_SERIALIZER_STRICT_ENUMS
+        CHECK(outcomes.throws == 5);
+        CHECK(outcomes.values.empty());
+        for (DeserializeError error : outcomes.errors) {
+            CHECK(error == DeserializeError::UnknownEnumValue);
+        }
+#else
+        // The first enumerator, as Deserialize<Priority> has always returned
+        CHECK(outcomes.throws == 0);
+        for (DeserializeError error : outcomes.errors) {
+            CHECK(error == DeserializeError::Ok);
+        }
+        CHECK(outcomes.values.size() == 9);
+        for (Priority value : outcomes.values) {
+            CHECK(value == Priority::Low);
+        }
+#endif
+    }
+
+#if NAYAN_SERIALIZER_STRICT_ENUMS
+    // Reported at the start of the name, in the field that holds it
+    Project project;
+    StdString json = "{\"name\":\"n\",\"lead\":{\"title\":\"t\",\"priority\":\"Someday\"}}";
+    DeserializeStatus status = SerializationUtility::TryDeserialize(json, project);
+    CHECK(status.error == DeserializeError::UnknownEnumValue);
+    CHECK(status.offset == 43);
+    CHECK(status.field != nullptr && std::strcmp(status.field, "priority") == 0);
+#endif
+}
+
+int main() {
+    RUN_TEST(reads_known_names_case_insensitively);
+    RUN_TEST(treats_unknown_names_the_same_on_every_path);
+    return nayan::serializer::test::Finish();
+}
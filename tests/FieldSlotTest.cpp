@@ -0,0 +1,103 @@
+// The generated FieldSlot: every declared name finds its own slot, with or without the expected
+// slot hint, and anything else (near-misses included) is rejected. Built a second time with
+// NAYAN_SERIALIZER_FIELD_MATCH_STATS=1 to check the FieldMatchCounter counts.
+
+#include "SampleData.h"
+#include "TaskSummary.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+template<typename T>
+static int slot_of(const StdString& key, int expectedSlot = -1) {
+    return T::FieldSlot(key.data(), key.size(), expectedSlot);
+}
+
+template<typename T>
+static void check_slots(const StdVector<StdString>& names) {
+    StdVector<int> slots;
+    for (const StdString& name : names) {
+        int slot = slot_of<T>(name);
+        CHECK(slot >= 0 && slot < static_cast<int>(names.size()));
+        for (int other : slots) {
+            CHECK(other != slot);
+        }
+        slots.push_back(slot);
+    }
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        // The hint only short-cuts the lookup, whichever slot it names
+        for (int hint = -1; hint < static_cast<int>(names.size()); ++hint) {
+            CHECK(slot_of<T>(names[i], hint) == slots[i]);
+        }
+
+        // Near-misses: truncated, extended, one byte changed, case changed, embedded NUL
+        const StdString& name = names[i];
+        StdVector<StdString> misses = {name.substr(0, name.size() - 1), name + "s", " " + name, StdString(name.c_str(), name.size() + 1)};
+        for (size_t at = 0; at < name.size(); ++at) {
+            StdString changed = name;
+            changed[at] = static_cast<char>(changed[at] ^ 0x20);
+            misses.push_back(changed);
+            changed[at] = static_cast<char>(name[at] + 1);
+            misses.push_back(changed);
+        }
+        for (const StdString& miss : misses) {
+            bool declared = false;
+            for (const StdString& other : names) {
+                declared = declared || other == miss;
+            }
+            if (!declared) {
+                CHECK(slot_of<T>(miss) == -1);
+                CHECK(slot_of<T>(miss, slots[i]) == -1);
+            }
+        }
+    }
+    CHECK(slot_of<T>("") == -1);
+}
+
+static void finds_every_declared_name() {
+    check_slots<Task>({"title", "estimate", "priority", "checkpoints", "attachment", "checksum"});
+    check_slots<Project>({"name", "budget", "active", "lead", "tasks", "labels"});
+    check_slots<TaskSummary>({"checkpoints", "title"});
+
+    // Names of another class are unknown here
+    CHECK(slot_of<TaskSummary>("estimate") == -1);
+    CHECK(slot_of<Project>("title") == -1);
+    CHECK(slot_of<Task>("name") == -1);
+}
+
+static void counts_ordered_and_hashed_matches() {
+    Project project = MakeProject(4);
+    StdString json = ToJson(project);
+    FieldMatchCounter::ResetStats();
+    Project back;
+    CHECK(SerializationUtility::TryDeserialize(json, back));
+    FieldMatchStats inOrder = FieldMatchCounter::Stats();
+
+    // The same members in reverse order: every key after the first misses the hint
+    StdString reversed = "{\"labels\":{},\"tasks\":[],\"lead\":{\"checksum\":null,\"title\":\"t\"},\"active\":true,\"budget\":1,\"name\":\"n\"}";
+    FieldMatchCounter::ResetStats();
+    CHECK(SerializationUtility::TryDeserialize(reversed, back));
+    FieldMatchStats outOfOrder = FieldMatchCounter::Stats();
+
+#if NAYAN_SERIALIZER_FIELD_MATCH_STATS
+    // Keys written by this library arrive in declaration order: 6 per object, project, lead and 4 tasks
+    CHECK(inOrder.orderedHits == 6 * 6);
+    CHECK(inOrder.hashLookups == 0);
+    CHECK(inOrder.HitRate() == 1.0);
+    CHECK(outOfOrder.orderedHits == 0);
+    CHECK(outOfOrder.hashLookups == 8);
+    CHECK(outOfOrder.HitRate() == 0.0);
+#else
+    // Counting is compiled out
+    CHECK(inOrder.orderedHits == 0 && inOrder.hashLookups == 0);
+    CHECK(outOfOrder.orderedHits == 0 && outOfOrder.hashLookups == 0);
+#endif
+}
+
+int main() {
+    RUN_TEST(finds_every_declared_name);
+    RUN_TEST(counts_ordered_and_hashed_matches);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,86 @@
+// ForEachElement over stream, fd, memory and chunked sources: every element of a top-level array
+// is delivered in order, the callback can stop early, and malformed input or a failing source is
+// reported.
+
+#include <sstream>
+#include <cstdio>
+#include <unistd.h>
+#include "SampleData.h"
+#include "TestSources.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void reads_elements_from_every_source() {
+    StdVector<Task> tasks = MakeTasks(3000);
+    StdString compact = SerializationUtility::Serialize(tasks);
+    StdString spaced = " \n[ ";
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        spaced += i != 0 ? " ,\n " : "";
+        spaced += ToJson(tasks[i]);
+    }
+    spaced += " ] ";
+
+    for (const StdString* text : {&compact, &spaced}) {
+        std::istringstream stream(*text);
+        IstreamSource streamSource(stream);
+        size_t count = 0;
+        DeserializeStatus status = SerializationUtility::ForEachElement<Task>(streamSource, [&](Task& task) {
+            CHECK(ToJson(task) == ToJson(tasks[count]));
+            ++count;
+        });
+        CHECK(status && count == tasks.size());
+
+        ChunkedSource chunked(*text, 3);
+        count = 0;
+        status = SerializationUtility::ForEachElement<Task>(chunked, [&](const Task& task) {
+            CHECK(ToJson(task) == ToJson(tasks[count]));
+            ++count;
+        });
+        CHECK(status && count == tasks.size());
+    }
+
+    FILE* file = std::tmpfile();
+    CHECK(file != nullptr);
+    if (file != nullptr) {
+        std::fwrite(compact.data(), 1, compact.size(), file);
+        std::fflush(file);
+        lseek(fileno(file), 0, SEEK_SET);
+        FdSource fdSource(fileno(file));
+        size_t count = 0;
+        CHECK(SerializationUtility::ForEachElement<Task>(fdSource, [&](Task&) { ++count; }));
+        CHECK(count == tasks.size());
+        std::fclose(file);
+    }
+
+    // Returning false stops the iteration
+    MemorySource memory(compact.data(), compact.size());
+    size_t seen = 0;
+    CHECK(SerializationUtility::ForEachElement<Task>(memory, [&](Task&) { return ++seen < 10; }));
+    CHECK(seen == 10);
+
+    const char* numbers = "[1, -2 ,3]";
+    MemorySource numberSource(numbers, std::strlen(numbers));
+    StdVector<int> values;
+    CHECK(SerializationUtility::ForEachElement<int>(numberSource, [&](int value) { values.push_back(value); }));
+    CHECK(values == (StdVector<int>{1, -2, 3}));
+}
+
+static void reports_element_errors() {
+    const char* invalid[] = {"", "   ", "{}", "[1,]", "[,1]", "[1 2]", "[1", "[1,2", "[\"abc", "[1}]",
+                             "[{\"title\":\" \"}]", "[{\"title\":\"t\",\"estimate\":\"x\"}]", "[{} {}]"};
+    for (const char* text : invalid) {
+        MemorySource source(text, std::strlen(text));
+        CHECK(!SerializationUtility::ForEachElement<Task>(source, [](Task&) {}));
+    }
+
+    BrokenSource broken("[1,");
+    CHECK(SerializationUtility::ForEachElement<int>(broken, [](int) {}).error == DeserializeError::IoError);
+}
+
+int main() {
+    RUN_TEST(reads_elements_from_every_source);
+    RUN_TEST(reports_element_errors);
+    return nayan::serializer::test::Finish();
+}
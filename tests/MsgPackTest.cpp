@@ -0,0 +1,186 @@
+// MessagePack round trips through MsgPackWriter/MsgPackReader: generated objects, containers, every
+// integer and string width, truncated and malformed input, and objects that only have the
+// document path (SerializeTo/TryFromJson, no WriteTo/ReadFrom).
+
+#include <limits>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void round_trips_generated_objects() {
+    Project project = MakeProject(20);
+    StdString msgpack = SerializationUtility::SerializeMsgPack(project);
+    CHECK(project.SerializeMsgPack() == msgpack);
+    CHECK(msgpack.size() < SerializationUtility::Serialize(project).size());
+
+    Project back;
+    CHECK(SerializationUtility::TryDeserializeMsgPack(msgpack, back));
+    CHECK(ToJson(back) == ToJson(project));
+    CHECK(ToJson(Project::DeserializeMsgPack(msgpack)) == ToJson(project));
+
+    // Appends to existing output
+    StdString prefixed = "xyz";
+    SerializationUtility::SerializeMsgPack(project, prefixed);
+    CHECK(prefixed.compare(3, StdString::npos, msgpack) == 0);
+}
+
+template<typename T>
+static void check_round_trip(const T& value) {
+    StdString msgpack = SerializationUtility::SerializeMsgPack(value);
+    T back{};
+    CHECK(SerializationUtility::TryDeserializeMsgPack(msgpack, back));
+    CHECK(back == value);
+}
+
+static void round_trips_every_integer_width() {
+    // Boundaries of positive/negative fixint, int8/16/32/64 and uint8/16/32/64
+    check_round_trip(StdVector<long>{0, 1, 127, 128, 255, 256, 65535, 65536, 4294967295L, 4294967296L,
+                                     -1, -32, -33, -128, -129, -32768, -32769, -2147483648L, -2147483649L,
+                                     std::numeric_limits<long>::min(), std::numeric_limits<long>::max()});
+    check_round_trip(StdVector<unsigned long>{0, 255, 65535, 4294967295UL, std::numeric_limits<unsigned long>::max()});
+    check_round_trip(StdVector<double>{0.0, -0.5, 1e300, 1.0 / 3});
+    check_round_trip(StdVector<float>{0.25f, -1e30f});
+    check_round_trip(StdVector<bool>{true, false});
+
+    // A value that does not fit the target type is rejected, not truncated
+    StdString msgpack = SerializationUtility::SerializeMsgPack(StdVector<long>{70000});
+    StdVector<short> shorts;
+    CHECK(SerializationUtility::TryDeserializeMsgPack(msgpack, shorts).error == DeserializeError::OutOfRange);
+}
+
+static void round_trips_every_string_and_container_width() {
+    // fixstr, str8, str16 and str32 headers
+    const size_t lengths[] = {0, 31, 32, 255, 256, 65535, 65536};
+    for (size_t length : lengths) {
+        StdString text(length, 'a');
+        if (length != 0) {
+            text[length - 1] = '"';
+        }
+        check_round_trip(text);
+    }
+
+    // fixarray/array16/array32 and fixmap/map16
+    StdVector<int> large(70000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<int>(i) - 35000;
+    }
+    check_round_trip(StdVector<int>(15, 7));
+    check_round_trip(StdVector<int>(16, 7));
+    check_round_trip(large);
+    StdMap<StdString, int> map;
+    for (int i = 0; i < 40; ++i) {
+        map["key" + std::to_string(i)] = i;
+    }
+    check_round_trip(map);
+    check_round_trip(StdVector<StdVector<StdString>>{{"a", "b"}, {}, {"\xc3\xa9"}});
+}
+
+static void counted_and_uncounted_headers_match() {
+    // BeginArray(count) writes the header up front; BeginArray() widens it on EndArray
+    for (size_t count : {size_t(0), size_t(15), size_t(16), size_t(65535), size_t(65536)}) {
+        StdString counted;
+        StdString widened;
+        MsgPackWriter countedWriter(counted);
+        MsgPackWriter widenedWriter(widened);
+        countedWriter.BeginArray(count);
+        widenedWriter.BeginArray();
+        for (size_t i = 0; i < count; ++i) {
+            countedWriter.BeginObject(1);
+            widenedWriter.BeginObject();
+            countedWriter.Key("i", 1);
+            widenedWriter.Key("i", 1);
+            countedWriter.WriteUInt(i);
+            widenedWriter.WriteUInt(i);
+            countedWriter.EndObject();
+            widenedWriter.EndObject();
+        }
+        countedWriter.EndArray();
+        widenedWriter.EndArray();
+        CHECK(counted == widened);
+    }
+    // An uncounted container nested in a counted one is still counted by its parent
+    StdString nested;
+    MsgPackWriter writer(nested);
+    writer.BeginArray(2);
+    writer.BeginArray();
+    writer.WriteNull();
+    writer.EndArray();
+    writer.WriteNull();
+    writer.EndArray();
+    CHECK(nested == StdString("\x92\x91\xc0\xc0"));
+}
+
+static void rejects_truncated_and_malformed_input() {
+    StdString msgpack = SerializationUtility::SerializeMsgPack(MakeProject(3));
+    for (size_t length = 0; length < msgpack.size(); ++length) {
+        Project project;
+        CHECK(!SerializationUtility::TryDeserializeMsgPack(msgpack.data(), length, project));
+    }
+    CHECK_THROWS(SerializationUtility::DeserializeMsgPack<Project>(msgpack.data(), msgpack.size() / 2));
+
+    // 0xc1 is never used; a map where an array is expected is a type mismatch
+    const char neverUsed[] = {'\xc1'};
+    StdVector<int> values;
+    CHECK(!SerializationUtility::TryDeserializeMsgPack(neverUsed, sizeof(neverUsed), values));
+    const char mapInsteadOfArray[] = {'\x81', '\xa1', 'a', '\x01'};
+    CHECK(SerializationUtility::TryDeserializeMsgPack(mapInsteadOfArray, sizeof(mapInsteadOfArray), values).error == DeserializeError::TypeMismatch);
+}
+
+static void validates_like_json() {
+    Project project = MakeProject(1);
+    project.lead->title = "   ";
+    Project back;
+    DeserializeStatus status = SerializationUtility::TryDeserializeMsgPack(SerializationUtility::SerializeMsgPack(project), back);
+    CHECK(status.error == DeserializeError::ValidationFailed);
+}
+
+// A Project that can only go through an ArduinoJson document
+struct DocumentOnlyProject {
+    Project project;
+
+    void SerializeTo(JsonObject out) const {
+        project.SerializeTo(out);
+    }
+
+    static DocumentOnlyProject FromJson(JsonVariantConst value) {
+        return DocumentOnlyProject{Project::FromJson(value)};
+    }
+
+    static DeserializeStatus TryFromJson(JsonVariantConst value, DocumentOnlyProject& out) {
+        return Project::TryFromJson(value, out.project);
+    }
+};
+
+static void round_trips_through_the_document() {
+    for (size_t count : {size_t(0), size_t(15), size_t(16), size_t(300)}) {
+        DocumentOnlyProject value{MakeProject(count)};
+        StdString msgpack = SerializationUtility::SerializeMsgPack(value);
+        // Replaying the document writes the same bytes as the generated WriteTo
+        CHECK(msgpack == SerializationUtility::SerializeMsgPack(value.project));
+
+        DocumentOnlyProject back;
+        CHECK(SerializationUtility::TryDeserializeMsgPack(msgpack, back));
+        CHECK(ToJson(back.project) == ToJson(value.project));
+        CHECK(ToJson(SerializationUtility::DeserializeMsgPack<DocumentOnlyProject>(msgpack).project) == ToJson(value.project));
+    }
+
+    DocumentOnlyProject invalid{MakeProject(1)};
+    invalid.project.lead->title = "   ";
+    DocumentOnlyProject back;
+    StdString msgpack = SerializationUtility::SerializeMsgPack(invalid);
+    CHECK(SerializationUtility::TryDeserializeMsgPack(msgpack, back).error == DeserializeError::ValidationFailed);
+    CHECK(!SerializationUtility::TryDeserializeMsgPack(msgpack.data(), msgpack.size() / 2, back));
+}
+
+int main() {
+    RUN_TEST(round_trips_generated_objects);
+    RUN_TEST(round_trips_every_integer_width);
+    RUN_TEST(round_trips_every_string_and_container_width);
+    RUN_TEST(counted_and_uncounted_headers_match);
+    RUN_TEST(rejects_truncated_and_malformed_input);
+    RUN_TEST(validates_like_json);
+    RUN_TEST(round_trips_through_the_document);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,120 @@
+// NdjsonWriter and NdjsonReader: round trips through chunked sources, one error per bad line
+// without losing the following records, and source and sink failures.
+
+#include <sstream>
+#include "SampleData.h"
+#include "TestSources.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void round_trips_ndjson() {
+    StdVector<Task> tasks = MakeTasks(3000);
+    std::ostringstream stream;
+    OstreamSink sink(stream);
+    {
+        NdjsonWriter<Task> writer(sink);
+        for (const Task& task : tasks) {
+            CHECK(writer.Write(task));
+        }
+        CHECK(writer.Flush());
+        CHECK(writer.Count() == tasks.size());
+    }
+    StdString text = stream.str();
+    StdString expected;
+    for (const Task& task : tasks) {
+        expected += ToJson(task) + "\n";
+    }
+    CHECK(text == expected);
+
+    for (size_t chunk : {size_t(5), size_t(100000)}) {
+        ChunkedSource source(text, chunk);
+        NdjsonReader<Task> reader(source);
+        Task task;
+        DeserializeStatus status;
+        size_t count = 0;
+        while (reader.Next(task, status)) {
+            CHECK(status);
+            CHECK(count < tasks.size() && ToJson(task) == ToJson(tasks[count]));
+            ++count;
+            CHECK(reader.Line() == count);
+        }
+        CHECK(count == tasks.size() && reader.Errors() == 0);
+    }
+
+    // Strings with newlines are escaped, so every record stays on one line
+    std::ostringstream values;
+    OstreamSink valueSink(values);
+    NdjsonWriter<StdString> strings(valueSink);
+    strings.Write("a\nb");
+    strings.Write("");
+    CHECK(strings.Flush());
+    NdjsonWriter<optional<int>> numbers(valueSink);
+    numbers.Write(optional<int>());
+    numbers.Write(3);
+    CHECK(numbers.Flush());
+    CHECK(values.str() == "\"a\\nb\"\n\"\"\nnull\n3\n");
+}
+
+static void reports_ndjson_errors_per_line() {
+    StdString mixed = "{\"title\":\"a\",\"estimate\":1}\r\n\n   \n{\"title\":\"b\",\"estimate\":\"x\"}\n{\"title\":\" \"}\n"
+                      "not json\n{\"title\":\"c\"} trailing\n  {\"title\":\"d\"}  ";
+    for (size_t chunk : {size_t(5), size_t(100000)}) {
+        ChunkedSource source(mixed, chunk);
+        NdjsonReader<Task> reader(source);
+        Task task;
+        DeserializeStatus status;
+        StdString titles;
+        StdVector<size_t> errorLines;
+        while (reader.Next(task, status)) {
+            if (status) {
+                titles += *task.title;
+            } else {
+                errorLines.push_back(reader.Line());
+            }
+        }
+        CHECK(titles == "ad");
+        CHECK(errorLines == (StdVector<size_t>{4, 5, 6, 7}));
+        CHECK(reader.Errors() == 4);
+    }
+
+    // A failing line leaves the record as it was, even when only trailing text is wrong
+    StdString trailing = "{\"title\":\"first\"}\n{\"title\":\"second\"} junk\n";
+    ChunkedSource trailingSource(trailing, 7);
+    NdjsonReader<Task> trailingReader(trailingSource);
+    Task record;
+    DeserializeStatus recordStatus;
+    CHECK(trailingReader.Next(record, recordStatus) && recordStatus && *record.title == "first");
+    CHECK(trailingReader.Next(record, recordStatus) && recordStatus.error == DeserializeError::InvalidInput);
+    CHECK(*record.title == "first");
+    CHECK(!trailingReader.Next(record, recordStatus));
+
+    BrokenSource broken("{\"title\":\"a\"}\n{\"tit");
+    NdjsonReader<Task> reader(broken);
+    Task task;
+    DeserializeStatus status;
+    StdVector<DeserializeError> errors;
+    while (reader.Next(task, status)) {
+        errors.push_back(status.error);
+    }
+    CHECK(!errors.empty() && errors.front() == DeserializeError::Ok && errors.back() == DeserializeError::IoError);
+
+    size_t calls = 0;
+    CallbackSink failing([&](const char*, size_t) {
+        ++calls;
+        return false;
+    });
+    NdjsonWriter<Task> writer(failing);
+    bool ok = true;
+    for (const Task& item : MakeTasks(2000)) {
+        ok = writer.Write(item) && ok;
+    }
+    CHECK(!ok && !writer.Flush() && calls == 1);
+}
+
+int main() {
+    RUN_TEST(round_trips_ndjson);
+    RUN_TEST(reports_ndjson_errors_per_line);
+    return nayan::serializer::test::Finish();
+}
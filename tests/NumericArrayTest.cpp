@@ -0,0 +1,56 @@
+// Numeric arrays: the contiguous StdVector fast path against the element-by-element path
+// (std::list), on valid and invalid input.
+
+#include <list>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+template<typename T>
+static void check_numeric_array(const StdVector<T>& values) {
+    StdString json = SerializationUtility::Serialize(values);
+    StdVector<T> back;
+    CHECK(SerializationUtility::TryDeserialize(json, back));
+    CHECK(back == values);
+    // std::list takes the element-by-element path and must produce the same text
+    std::list<T> list(values.begin(), values.end());
+    CHECK(SerializationUtility::Serialize(list) == json);
+}
+
+static void round_trips_numeric_arrays() {
+    check_numeric_array(StdVector<int>{0, -1, 1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()});
+    check_numeric_array(StdVector<long>{std::numeric_limits<long>::min(), std::numeric_limits<long>::max()});
+    check_numeric_array(StdVector<unsigned long>{0, std::numeric_limits<unsigned long>::max()});
+    check_numeric_array(StdVector<double>{0.1, -2.5e-300, 1e308, 1.0 / 3});
+    check_numeric_array(StdVector<float>{0.1f, 1e30f, -3.25f});
+    check_numeric_array(StdVector<int>{});
+
+    // The bulk path and the element path agree on every input, valid or not
+    const char* tokens[] = {"0", "-0", "1", "127", "128", "-129", "2147483648", "-2147483649", "1.5", "1e3",
+                            "1e309", "-", "\"5\"", "\"x\"", "null", "true", "[1]", "{}", " 7 "};
+    Random random(11);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        StdString json = "[";
+        size_t count = random.Below(6);
+        for (size_t i = 0; i < count; ++i) {
+            json += i != 0 ? "," : "";
+            json += tokens[random.Below(sizeof(tokens) / sizeof(tokens[0]))];
+        }
+        json += random.Below(20) == 0 ? "" : "]";
+        StdVector<int> vector{42};
+        std::list<int> list{42};
+        DeserializeStatus vectorStatus = SerializationUtility::TryDeserialize(json, vector);
+        DeserializeStatus listStatus = SerializationUtility::TryDeserialize(json, list);
+        CHECK(static_cast<bool>(vectorStatus) == static_cast<bool>(listStatus));
+        CHECK(vectorStatus.error == listStatus.error);
+        CHECK(vectorStatus.offset == listStatus.offset);
+        CHECK(vector.size() == list.size() && std::equal(vector.begin(), vector.end(), list.begin()));
+    }
+}
+
+int main() {
+    RUN_TEST(round_trips_numeric_arrays);
+    return nayan::serializer::test::Finish();
+}
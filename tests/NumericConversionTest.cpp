@@ -0,0 +1,168 @@
+// NumericConversionUtility: status codes, sign handling and format/parse round trips. Built twice:
+// with std::to_chars/from_chars for floating point and with the snprintf/strtod fallback.
+
+#include <clocale>
+#include <cmath>
+#include <limits>
+#include <NumericConversionUtility.h>
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+template<typename T>
+static NumericConversionStatus parse(const char* text, T& out) {
+    return NumericConversionUtility::ParseNumber(text, text + std::strlen(text), out);
+}
+
+template<typename T>
+static StdString format(T value) {
+    StdString text;
+    CHECK(NumericConversionUtility::AppendNumber(value, text) == NumericConversionStatus::Ok);
+    return text;
+}
+
+template<typename T>
+static void check_round_trip(T value) {
+    StdString text = format(value);
+    T back{};
+    CHECK(NumericConversionUtility::ParseNumber(text.data(), text.data() + text.size(), back) == NumericConversionStatus::Ok);
+    CHECK(back == value || (value != value && back != back));
+    if (!(back == value)) {
+        std::fprintf(stderr, "round trip of %s failed\n", text.c_str());
+    }
+}
+
+static void accepts_one_leading_sign() {
+    int integer = 7;
+    double floating = 7;
+    CHECK(parse("+5", integer) == NumericConversionStatus::Ok && integer == 5);
+    CHECK(parse("-5", integer) == NumericConversionStatus::Ok && integer == -5);
+    CHECK(parse(" \t+1.5\r\n", floating) == NumericConversionStatus::Ok && floating == 1.5);
+
+    integer = 7;
+    floating = 7;
+    const char* invalid[] = {"+-5", "++5", "-+5", "--5", "+", "-", "", "   ", "+ 5", "5 5", "5x", "0x10", "1,5"};
+    for (const char* text : invalid) {
+        CHECK(parse(text, integer) == NumericConversionStatus::InvalidArgument);
+        CHECK(parse(text, floating) == NumericConversionStatus::InvalidArgument);
+    }
+    // Unchanged on failure
+    CHECK(integer == 7 && floating == 7);
+}
+
+static void reports_range_errors() {
+    signed char small = 0;
+    CHECK(parse("127", small) == NumericConversionStatus::Ok && small == 127);
+    CHECK(parse("128", small) == NumericConversionStatus::OutOfRange);
+    CHECK(parse("-129", small) == NumericConversionStatus::OutOfRange);
+    unsigned int natural = 0;
+    CHECK(parse("4294967295", natural) == NumericConversionStatus::Ok && natural == 4294967295u);
+    CHECK(parse("4294967296", natural) == NumericConversionStatus::OutOfRange);
+    CHECK(parse("-1", natural) == NumericConversionStatus::InvalidArgument);
+    int integer = 0;
+    CHECK(parse("1.5", integer) == NumericConversionStatus::InvalidArgument);
+    CHECK(parse("1e3", integer) == NumericConversionStatus::InvalidArgument);
+    double floating = 0;
+    CHECK(parse("1e309", floating) == NumericConversionStatus::OutOfRange);
+    float single = 0;
+    CHECK(parse("1e39", single) == NumericConversionStatus::OutOfRange);
+    CHECK(parse("3.4e38", single) == NumericConversionStatus::Ok);
+
+    char buffer[4];
+    size_t length = 0;
+    CHECK(NumericConversionUtility::FormatNumber(12345, buffer, sizeof(buffer), length) == NumericConversionStatus::BufferTooSmall);
+    CHECK(NumericConversionUtility::FormatNumber(0.123456, buffer, sizeof(buffer), length) == NumericConversionStatus::BufferTooSmall);
+    CHECK(NumericConversionUtility::FormatNumber(1234, buffer, sizeof(buffer), length) == NumericConversionStatus::Ok && length == 4);
+}
+
+static void formats_shortest_text() {
+    CHECK(format(0) == "0");
+    CHECK(format(-42) == "-42");
+    CHECK(format(std::numeric_limits<long>::min()) == std::to_string(std::numeric_limits<long>::min()));
+    CHECK(format(std::numeric_limits<unsigned long>::max()) == std::to_string(std::numeric_limits<unsigned long>::max()));
+    CHECK(format(0.1) == "0.1");
+    CHECK(format(1.5) == "1.5");
+    CHECK(format(100.0) == "100");
+    CHECK(format(-0.25f) == "-0.25");
+    CHECK(format(0.1f) == "0.1");
+}
+
+static void round_trips_integers() {
+    check_round_trip(std::numeric_limits<signed char>::min());
+    check_round_trip(std::numeric_limits<short>::max());
+    check_round_trip(std::numeric_limits<int>::min());
+    check_round_trip(std::numeric_limits<long>::min());
+    check_round_trip(std::numeric_limits<unsigned long>::max());
+    Random random(17);
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        uint64_t bits = random.Next() >> random.Below(64);
+        check_round_trip(static_cast<long>(bits));
+        check_round_trip(static_cast<unsigned long>(bits));
+        check_round_trip(static_cast<int>(bits));
+        check_round_trip(static_cast<short>(bits));
+    }
+}
+
+static void round_trips_floating_point() {
+    check_round_trip(0.0);
+    check_round_trip(-0.0);
+    check_round_trip(std::numeric_limits<double>::max());
+    check_round_trip(std::numeric_limits<double>::lowest());
+    check_round_trip(std::numeric_limits<double>::min());
+    check_round_trip(std::numeric_limits<double>::denorm_min());
+    check_round_trip(std::numeric_limits<float>::max());
+    check_round_trip(std::numeric_limits<float>::min());
+    check_round_trip(std::numeric_limits<float>::denorm_min());
+    check_round_trip(1.0 / 3);
+    check_round_trip(2.0f / 3);
+
+    // Random bit patterns cover every exponent, including subnormals
+    Random random(19);
+    for (int iteration = 0; iteration < 50000; ++iteration) {
+        uint64_t bits = random.Next();
+        double value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value)) {
+            check_round_trip(value);
+        }
+        uint32_t singleBits = static_cast<uint32_t>(bits);
+        float single = 0;
+        std::memcpy(&single, &singleBits, sizeof(single));
+        if (std::isfinite(single)) {
+            check_round_trip(single);
+        }
+    }
+}
+
+static void ignores_the_c_locale() {
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "ru_RU.UTF-8"};
+    const char* active = nullptr;
+    for (const char* name : locales) {
+        if (std::setlocale(LC_NUMERIC, name) != nullptr) {
+            active = name;
+            break;
+        }
+    }
+    if (active == nullptr) {
+        std::printf("  (no locale with a ',' decimal point installed, checking the C locale only)\n");
+    }
+    CHECK(format(1.5) == "1.5");
+    CHECK(format(-0.125f) == "-0.125");
+    double value = 0;
+    CHECK(parse("2.75", value) == NumericConversionStatus::Ok && value == 2.75);
+    CHECK(parse("2,75", value) == NumericConversionStatus::InvalidArgument);
+    check_round_trip(1.0 / 7);
+    std::setlocale(LC_NUMERIC, "C");
+}
+
+int main() {
+    std::printf("floating point charconv: %d\n", NAYAN_SERIALIZER_FLOAT_CHARCONV);
+    RUN_TEST(accepts_one_leading_sign);
+    RUN_TEST(reports_range_errors);
+    RUN_TEST(formats_shortest_text);
+    RUN_TEST(round_trips_integers);
+    RUN_TEST(round_trips_floating_point);
+    RUN_TEST(ignores_the_c_locale);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,112 @@
+// The generated pull parser (ReadFrom behind TryDeserialize and Deserialize): unknown members are
+// skipped, malformed and truncated input is reported with the right error code, field and offset.
+
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void skips_unknown_members() {
+    const char* json = " { \"extra\" : [1, {\"a\": [true, null, \"x\\u00e9\"]}, -2.5e3], \"name\":\"a\\tb\", \"budget\": 1e2,"
+                       " \"lead\": {\"title\":\"z\",\"estimate\": \"42\", \"more\": {}}, \"active\": null } ";
+    Project project;
+    DeserializeStatus status = SerializationUtility::TryDeserialize(json, std::strlen(json), project);
+    CHECK(status);
+    CHECK(project.name == StdString("a\tb"));
+    CHECK(project.budget == 100.0);
+    CHECK(project.lead.has_value() && project.lead->estimate == 42);
+    CHECK(!project.active.has_value());
+}
+
+static void reports_malformed_input() {
+    // Syntax errors are reported where the parser stopped, rejected values at their start
+    struct Case {
+        const char* json;
+        DeserializeError error;
+        const char* field;
+        size_t offset;
+    };
+    const Case cases[] = {
+        {"", DeserializeError::EmptyInput, nullptr, 0},
+        {"{\"name\":\"n\",}", DeserializeError::InvalidInput, nullptr, 12},
+        {"{\"name\":\"n\",\"lead\":{\"title\":\"t\",\"estimate\":1.5}}", DeserializeError::TypeMismatch, "estimate", 43},
+        {"{\"name\":\"n\",\"lead\":{\"title\":\"t\",\"estimate\":99999999999}}", DeserializeError::OutOfRange, "estimate", 43},
+        {"{\"name\":\"n\"", DeserializeError::IncompleteInput, nullptr, 11},
+        {"[1]", DeserializeError::TypeMismatch, nullptr, 0},
+        {"{\"name\":\"n\",\"lead\":{\"title\":\"t\",\"priority\":3}}", DeserializeError::TypeMismatch, "priority", 43},
+        {"{\"name\":\"n\",\"lead\":{\"title\":\"t\",\"checkpoints\":[1 2]}}", DeserializeError::InvalidInput, "checkpoints", 49},
+        {"{\"name\":\"n\",\"extra\":[1 2],\"lead\":{\"title\":\"t\"}}", DeserializeError::InvalidInput, nullptr, 23},
+        {"{\"name\":\"n\",\"extra\":tru,\"lead\":{\"title\":\"t\"}}", DeserializeError::InvalidInput, nullptr, 20},
+        {"{\"name\":\"n\",\"lead\":{\"title\":\"  \"}}", DeserializeError::ValidationFailed, "title", 0},
+        {"{\"name\":\"n\"}", DeserializeError::ValidationFailed, "lead", 0},
+    };
+    for (const Case& c : cases) {
+        Project project;
+        project.name = "unchanged";
+        DeserializeStatus status = SerializationUtility::TryDeserialize(c.json, std::strlen(c.json), project);
+        CHECK(!status);
+        if (status.error != c.error || status.offset != c.offset) {
+            std::fprintf(stderr, "%s -> %s at %zu\n", c.json, status.c_str(), status.offset);
+        }
+        CHECK(status.error == c.error);
+        CHECK(status.offset == c.offset);
+        CHECK(c.field == nullptr ? status.field == nullptr : status.field != nullptr && std::strcmp(status.field, c.field) == 0);
+        // The target is left as it was
+        CHECK(project.name == StdString("unchanged") && !project.lead.has_value());
+    }
+
+    // Every truncation of a valid document is an error
+    StdString json = SerializationUtility::Serialize(MakeProject(3));
+    for (size_t length = 0; length < json.size(); ++length) {
+        Project project;
+        CHECK(!SerializationUtility::TryDeserialize(json.data(), length, project));
+    }
+}
+
+static void error_messages_do_not_echo_the_input() {
+    StdString secret = "{\"name\":\"" + StdString(10000, 's') + "\",\"lead\":{\"title\":\"t\",\"estimate\":true}}";
+    StdString message;
+    try {
+        SerializationUtility::Deserialize<Project>(secret);
+    } catch (const std::exception& e) {
+        message = e.what();
+    }
+    CHECK(message == "JSON parse error: TypeMismatch in field 'estimate' at offset 10042");
+
+    StdVector<Task> tasks = MakeTasks(50);
+    StdString array = SerializationUtility::Serialize(tasks);
+    array.back() = ',';
+    try {
+        message.clear();
+        SerializationUtility::Deserialize<StdVector<Task>>(array);
+    } catch (const std::exception& e) {
+        message = e.what();
+    }
+    CHECK(!message.empty() && message.size() < 100);
+
+    // Validation failures are reported from the status, as for TryDeserialize
+    try {
+        message.clear();
+        Project::Deserialize("{\"name\":\"n\",\"lead\":{\"title\":\" \"}}");
+    } catch (const std::exception& e) {
+        message = e.what();
+    }
+    CHECK(message == "Validation error: ValidationFailed in field 'title'");
+
+    // Primitives quote a bounded excerpt
+    try {
+        message.clear();
+        SerializationUtility::Deserialize<int>(StdString(1000, '7') + "x");
+    } catch (const std::exception& e) {
+        message = e.what();
+    }
+    CHECK(message == "Invalid integer value: '" + StdString(32, '7') + "...' (1001 characters)");
+}
+
+int main() {
+    RUN_TEST(skips_unknown_members);
+    RUN_TEST(reports_malformed_input);
+    RUN_TEST(error_messages_do_not_echo_the_input);
+    return nayan::serializer::test::Finish();
+}
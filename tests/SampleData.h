@@ -0,0 +1,85 @@
+#ifndef SERIALIZATIONLIB_SAMPLE_DATA_H
+#define SERIALIZATIONLIB_SAMPLE_DATA_H
+
+#include <string>
+#include "Project.h"
+
+namespace nayan {
+namespace serializer {
+namespace test {
+
+/**
+ * Compact JSON of a value through the generated WriteTo; DTOs have no operator==, so round
+ * trips are compared by their text.
+ */
+template<typename T>
+StdString ToJson(const T& value) {
+    StdString text;
+    JsonWriter<StdString> writer(text);
+    SerializationUtility::Write(writer, value);
+    return text;
+}
+
+inline Task MakeTask(size_t index) {
+    Task task;
+    task.title = "task \"" + std::to_string(index) + "\"\n\t\x01 \xc3\xa9";
+    task.estimate = static_cast<int>(index) * 3 - 7;
+    task.priority = index % 3 == 0 ? Priority::Urgent : Priority::Normal;
+    task.checkpoints = StdVector<int>{1, -2, static_cast<int>(index) * 100000};
+    if (index % 2 == 0) {
+        task.attachment = Base64Bytes(index % 17, static_cast<UInt8>(index));
+    }
+    if (index % 3 == 0) {
+        Base64Array<4> checksum;
+        for (size_t i = 0; i < checksum.size(); ++i) {
+            checksum[i] = static_cast<UInt8>(index + i * 85);
+        }
+        task.checksum = checksum;
+    }
+    return task;
+}
+
+/**
+ * Tasks whose titles also contain text that looks like structure, to catch readers that split
+ * on bytes inside strings.
+ */
+inline StdVector<Task> MakeTasks(size_t count) {
+    StdVector<Task> tasks;
+    for (size_t i = 0; i < count; ++i) {
+        tasks.push_back(MakeTask(i));
+        *tasks.back().title += " ]},[\\";
+    }
+    return tasks;
+}
+
+/**
+ * A Project with every kind of field filled: strings needing escapes, numbers, nested objects,
+ * containers, enums and base64 buffers. Optional fields are left empty on some tasks.
+ */
+inline Project MakeProject(size_t taskCount) {
+    Project project;
+    project.name = "project \\ \"alpha\"";
+    project.budget = 1234.5;
+    project.active = true;
+    project.lead = MakeTask(0);
+    StdVector<Task> tasks;
+    for (size_t i = 0; i < taskCount; ++i) {
+        tasks.push_back(MakeTask(i + 1));
+        if (i % 4 == 3) {
+            tasks.back().estimate.reset();
+        }
+    }
+    project.tasks = tasks;
+    StdMap<StdString, int> labels;
+    for (int i = 0; i < 5; ++i) {
+        labels["label" + std::to_string(i)] = i * 1000;
+    }
+    project.labels = labels;
+    return project;
+}
+
+} // namespace test
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATIONLIB_SAMPLE_DATA_H
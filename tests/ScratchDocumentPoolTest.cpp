@@ -0,0 +1,83 @@
+// ScratchDocumentPool: pooled documents and their storage are reused, so in steady state the
+// miss counters stop growing; nesting deeper than the pool still works.
+
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void parse_in_lease(const StdString& json) {
+    DocumentLease lease = ScratchDocumentPool::Local().Acquire();
+    CHECK(lease.Document().isNull());
+    CHECK(!deserializeJson(lease.Document(), json));
+}
+
+static void reaches_a_steady_state() {
+    ScratchDocumentPool& pool = ScratchDocumentPool::Local();
+    StdString json = ToJson(MakeProject(30));
+
+    // Warm up: the first rounds construct the documents and allocate their storage
+    for (int round = 0; round < 3; ++round) {
+        parse_in_lease(json);
+        optional<Project> project = SerializationUtility::Deserialize<optional<Project>>(json);
+        CHECK(project.has_value() && ToJson(*project) == json);
+    }
+
+    pool.ResetStats();
+    for (int round = 0; round < 50; ++round) {
+        parse_in_lease(json);
+        optional<Project> project = SerializationUtility::Deserialize<optional<Project>>(json);
+        CHECK(project.has_value() && ToJson(*project) == json);
+    }
+    ScratchPoolStats stats = pool.Stats();
+    CHECK(stats.documentMisses == 0);
+    CHECK(stats.documentHits >= 100);
+    CHECK(stats.storageMisses == 0);
+    CHECK(stats.storageHits > 0);
+}
+
+static void acquire_nested(size_t depth) {
+    StdVector<DocumentLease> leases;
+    leases.reserve(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        leases.push_back(ScratchDocumentPool::Local().Acquire());
+        CHECK(leases.back().Document().isNull());
+        leases.back().Document()["index"] = static_cast<int>(i);
+    }
+    // Every lease has its own document
+    for (size_t i = 0; i < depth; ++i) {
+        CHECK(leases[i].Document()["index"].as<int>() == static_cast<int>(i));
+    }
+}
+
+static void nests_beyond_the_pool_size() {
+    ScratchDocumentPool& pool = ScratchDocumentPool::Local();
+    acquire_nested(ScratchDocumentPool::PoolSize + 2);
+    pool.ResetStats();
+    acquire_nested(ScratchDocumentPool::PoolSize + 2);
+    ScratchPoolStats stats = pool.Stats();
+    // Only the two leases past the pool size construct a temporary document
+    CHECK(stats.documentHits == ScratchDocumentPool::PoolSize);
+    CHECK(stats.documentMisses == 2);
+    CHECK(stats.storageMisses == 0);
+}
+
+static void trim_releases_idle_storage() {
+    ScratchDocumentPool& pool = ScratchDocumentPool::Local();
+    parse_in_lease(ToJson(MakeProject(5)));
+    pool.Trim();
+    pool.ResetStats();
+    parse_in_lease(ToJson(MakeProject(5)));
+    ScratchPoolStats stats = pool.Stats();
+    // The storage (and the idle documents) had to be created again
+    CHECK(stats.documentMisses == 1);
+    CHECK(stats.storageMisses > 0);
+}
+
+int main() {
+    RUN_TEST(reaches_a_steady_state);
+    RUN_TEST(nests_beyond_the_pool_size);
+    RUN_TEST(trim_releases_idle_storage);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,79 @@
+// Serialize(value, sink) into ostream, fd and callback sinks: the output matches Serialize into a
+// string, chunks never exceed the sink buffer and the first sink failure stops the write.
+
+#include <sstream>
+#include <cstdio>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+// Reads the whole file behind `file` from the start
+static StdString read_file(FILE* file) {
+    StdString text;
+    char buffer[4096];
+    std::rewind(file);
+    size_t count = 0;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, count);
+    }
+    return text;
+}
+
+static void writes_to_every_sink() {
+    StdVector<Task> tasks = MakeTasks(5000);
+    StdString expected = SerializationUtility::Serialize(tasks);
+
+    std::ostringstream stream;
+    OstreamSink streamSink(stream);
+    CHECK(SerializationUtility::Serialize(tasks, streamSink));
+    CHECK(stream.str() == expected);
+
+    size_t largestChunk = 0;
+    StdString collected;
+    CallbackSink callbackSink([&](const char* data, size_t length) {
+        largestChunk = std::max(largestChunk, length);
+        collected.append(data, length);
+        return true;
+    });
+    CHECK(SerializationUtility::Serialize(tasks, callbackSink));
+    CHECK(collected == expected);
+    CHECK(largestChunk <= NAYAN_SERIALIZER_SINK_BUFFER_SIZE);
+
+    FILE* file = std::tmpfile();
+    CHECK(file != nullptr);
+    if (file != nullptr) {
+        FdSink fdSink(fileno(file));
+        CHECK(SerializationUtility::Serialize(tasks, fdSink));
+        CHECK(read_file(file) == expected);
+        std::fclose(file);
+    }
+
+    // Generated method, empty optional, enum
+    std::ostringstream single;
+    OstreamSink singleSink(single);
+    CHECK(tasks[3].Serialize(singleSink));
+    CHECK(single.str() == tasks[3].Serialize());
+    std::ostringstream other;
+    OstreamSink otherSink(other);
+    CHECK(SerializationUtility::Serialize(optional<int>(), otherSink) && other.str().empty());
+    CHECK(SerializationUtility::Serialize(Priority::Urgent, otherSink));
+    CHECK(other.str() == SerializationUtility::Serialize(Priority::Urgent));
+}
+
+static void stops_at_the_first_sink_failure() {
+    size_t calls = 0;
+    CallbackSink failing([&](const char*, size_t) {
+        ++calls;
+        return false;
+    });
+    CHECK(!SerializationUtility::Serialize(MakeTasks(2000), failing));
+    CHECK(calls == 1);
+}
+
+int main() {
+    RUN_TEST(writes_to_every_sink);
+    RUN_TEST(stops_at_the_first_sink_failure);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,61 @@
+// StringScanner against byte-by-byte reference implementations.
+// Built twice: with the SIMD kernels selected at runtime and with NAYAN_SERIALIZER_DISABLE_SIMD.
+
+#include <string>
+#include <vector>
+#include <StringScanner.h>
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static size_t reference_find_escape(const char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c < 0x20 || c == '"' || c == '\\') {
+            return i;
+        }
+    }
+    return length;
+}
+
+static size_t reference_find_quote(const char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == '"' || data[i] == '\\') {
+            return i;
+        }
+    }
+    return length;
+}
+
+static void scanner_matches_reference() {
+    Random random(1);
+    for (int iteration = 0; iteration < 100000; ++iteration) {
+        size_t length = random.Below(100);
+        // Exact-size allocation, so a sanitizer build catches reads past the end
+        std::vector<char> text(length);
+        for (char& c : text) {
+            size_t pick = random.Below(200);
+            c = pick == 0 ? '"' : pick == 1 ? '\\' : pick == 2 ? static_cast<char>(random.Below(32)) : static_cast<char>(32 + random.Below(224));
+        }
+        CHECK(StringScanner::FindEscapeCharacter(text.data(), length) == reference_find_escape(text.data(), length));
+        CHECK(StringScanner::FindQuoteOrBackslash(text.data(), length) == reference_find_quote(text.data(), length));
+    }
+
+    // A special character at every position of a long run
+    std::string run(130, 'x');
+    for (size_t position = 0; position < run.size(); ++position) {
+        std::string text = run;
+        text[position] = '\n';
+        CHECK(StringScanner::FindEscapeCharacter(text.data(), text.size()) == position);
+        CHECK(StringScanner::FindQuoteOrBackslash(text.data(), text.size()) == text.size());
+        text[position] = '\\';
+        CHECK(StringScanner::FindQuoteOrBackslash(text.data(), text.size()) == position);
+    }
+}
+
+int main() {
+    std::printf("string scanner: %s\n", StringScanner::Backend());
+    RUN_TEST(scanner_matches_reference);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,122 @@
+// JsonStructuralIndex against a byte-by-byte reference, and the indexed reader against the plain one.
+// Built twice: with the SIMD kernels selected at runtime and with NAYAN_SERIALIZER_DISABLE_SIMD,
+// both with NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD set so TryDeserialize builds the index.
+
+#include <vector>
+#include <JsonStructuralIndex.h>
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+// Every unescaped quote; false if a string is unterminated. As in the index, a backslash outside
+// a string (invalid JSON the reader rejects anyway) also escapes a following quote.
+static bool reference_index(const char* data, size_t length, std::vector<uint32_t>& positions) {
+    bool inString = false;
+    bool escaped = false;
+    for (size_t i = 0; i < length; ++i) {
+        char c = data[i];
+        bool isEscaped = escaped;
+        escaped = c == '\\' && !isEscaped;
+        if (c == '"' && !isEscaped) {
+            positions.push_back(static_cast<uint32_t>(i));
+            inString = !inString;
+        }
+    }
+    return !inString;
+}
+
+static void index_matches_reference() {
+    // Few distinct characters, so quotes and backslash runs cross the 64-byte block boundaries
+    const char alphabet[] = {'"', '"', '\\', '\\', '{', '}', '[', ']', ':', ',', 'a', ' ', '\n', '\xc3'};
+    Random random(2);
+    for (int iteration = 0; iteration < 30000; ++iteration) {
+        size_t length = random.Below(300);
+        std::vector<char> text(length);
+        for (char& c : text) {
+            c = alphabet[random.Below(sizeof(alphabet))];
+        }
+        std::vector<uint32_t> expected;
+        bool expectedOk = reference_index(text.data(), length, expected);
+
+        JsonStructuralIndex index;
+        bool ok = index.Build(text.data(), length);
+        CHECK(ok == expectedOk);
+        if (ok && expectedOk) {
+            CHECK(index.Count() == expected.size());
+            CHECK(std::equal(expected.begin(), expected.end(), index.Positions()));
+        } else {
+            CHECK(index.Count() == 0);
+        }
+    }
+}
+
+static void index_handles_long_backslash_runs() {
+    // An odd run of backslashes escapes the quote after it, across any number of blocks
+    for (size_t run = 0; run < 200; ++run) {
+        StdString text = "[\"" + StdString(run, '\\') + "\",1]";
+        std::vector<uint32_t> expected;
+        bool expectedOk = reference_index(text.data(), text.size(), expected);
+        JsonStructuralIndex index;
+        CHECK(index.Build(text.data(), text.size()) == expectedOk);
+        CHECK(expectedOk == (run % 2 == 0));
+        if (expectedOk) {
+            CHECK(index.Count() == expected.size() && std::equal(expected.begin(), expected.end(), index.Positions()));
+        }
+    }
+}
+
+// Reads `json` once with a string index and once without; both must agree
+static void check_index_agrees(const StdString& json) {
+    JsonStructuralIndex index;
+    if (!index.Build(json.data(), json.size())) {
+        return;
+    }
+    Project plain;
+    Project indexed;
+    JsonReader plainReader(json.data(), json.size());
+    JsonReader indexedReader(json.data(), json.size(), index);
+    DeserializeStatus plainStatus = SerializationUtility::Read(plainReader, plain);
+    DeserializeStatus indexedStatus = SerializationUtility::Read(indexedReader, indexed);
+    CHECK(static_cast<bool>(plainStatus) == static_cast<bool>(indexedStatus));
+    CHECK(plainStatus.error == indexedStatus.error);
+    if (plainStatus && indexedStatus) {
+        CHECK(ToJson(plain) == ToJson(indexed));
+    }
+}
+
+static void structural_index_does_not_change_validity() {
+    const char* junk[] = {"1", "01", "tru", "true", "nul", "-", "1.", "\"a\"", "\"\\q\"", "[1,]", "[1 2]",
+                          "{\"a\":1}", "{\"a\" 1}", "{1:2}", "[]", "{}", ",", ":", "\"x\":1", "\"\\\"]\""};
+    Random random(7);
+    for (int iteration = 0; iteration < 5000; ++iteration) {
+        StdString json = "{\"name\":\"n\",\"extra\":[";
+        size_t count = random.Below(5);
+        for (size_t i = 0; i < count; ++i) {
+            json += i != 0 ? "," : "";
+            json += junk[random.Below(sizeof(junk) / sizeof(junk[0]))];
+        }
+        json += "],\"lead\":{\"title\":\"t\"}}";
+        check_index_agrees(json);
+    }
+
+    // Inputs above the threshold take the indexed path inside TryDeserialize
+    StdString large = SerializationUtility::Serialize(MakeProject(400));
+    CHECK(NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD != 0 && large.size() >= NAYAN_SERIALIZER_STRUCTURAL_INDEX_THRESHOLD);
+    check_index_agrees(large);
+    Project back;
+    CHECK(SerializationUtility::TryDeserialize(large, back));
+    CHECK(ToJson(back) == large);
+    StdString malformed = large;
+    malformed.insert(malformed.size() - 1, ",\"extra\":[1 2]");
+    CHECK(SerializationUtility::TryDeserialize(malformed, back).error == DeserializeError::InvalidInput);
+}
+
+int main() {
+    std::printf("structural index: %s\n", JsonStructuralIndex::Backend());
+    RUN_TEST(index_matches_reference);
+    RUN_TEST(index_handles_long_backslash_runs);
+    RUN_TEST(structural_index_does_not_change_validity);
+    return nayan::serializer::test::Finish();
+}
@@ -0,0 +1,61 @@
+#ifndef SERIALIZATIONLIB_TEST_SOURCES_H
+#define SERIALIZATIONLIB_TEST_SOURCES_H
+
+#include <algorithm>
+#include <cstring>
+#include <NayanSerializer.h>
+
+namespace nayan {
+namespace serializer {
+namespace test {
+
+/**
+ * Source returning at most `chunk` bytes per Read, so every token straddles buffer refills.
+ */
+struct ChunkedSource {
+    ChunkedSource(const StdString& text, size_t chunk) : text_(text), chunk_(chunk) {}
+
+    size_t Read(char* buffer, size_t capacity) {
+        size_t count = std::min(std::min(capacity, chunk_), text_.size() - position_);
+        std::memcpy(buffer, text_.data() + position_, count);
+        position_ += count;
+        return count;
+    }
+
+    bool Failed() const {
+        return false;
+    }
+
+    const StdString& text_;
+    size_t chunk_;
+    size_t position_ = 0;
+};
+
+/**
+ * Source that returns `prefix` and then reports a read error.
+ */
+struct BrokenSource {
+    explicit BrokenSource(const char* prefix) : prefix_(prefix) {}
+
+    size_t Read(char* buffer, size_t capacity) {
+        if (calls_++ != 0) {
+            return 0;
+        }
+        size_t count = std::min(capacity, std::strlen(prefix_));
+        std::memcpy(buffer, prefix_, count);
+        return count;
+    }
+
+    bool Failed() const {
+        return calls_ > 1;
+    }
+
+    const char* prefix_;
+    int calls_ = 0;
+};
+
+} // namespace test
+} // namespace serializer
+} // namespace nayan
+
+#endif // SERIALIZATIONLIB_TEST_SOURCES_H
@@ -0,0 +1,104 @@
+#ifndef SERIALIZATIONLIB_TEST_SUPPORT_H
+#define SERIALIZATIONLIB_TEST_SUPPORT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+/**
+ * Minimal test harness: every CHECK that fails is reported with its location and the test
+ * executable exits non-zero, so ctest shows all failures of a run instead of the first one.
+ *
+ *   int main() {
+ *       RUN_TEST(round_trips_through_json);
+ *       return nayan::serializer::test::Finish();
+ *   }
+ */
+
+namespace nayan {
+namespace serializer {
+namespace test {
+
+inline int& FailureCount() {
+    static int count = 0;
+    return count;
+}
+
+inline void ReportFailure(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+    ++FailureCount();
+}
+
+template<typename Test>
+void Run(const char* name, Test test) {
+    int failuresBefore = FailureCount();
+    try {
+        test();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: unexpected exception: %s\n", name, e.what());
+        ++FailureCount();
+    }
+    std::printf("[%s] %s\n", FailureCount() == failuresBefore ? "  OK  " : "FAILED", name);
+}
+
+inline int Finish() {
+    if (FailureCount() != 0) {
+        std::printf("%d check(s) failed\n", FailureCount());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Deterministic pseudo-random numbers (xorshift), so a failing randomized case can be replayed.
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed) : state_(seed != 0 ? seed : 1) {}
+
+    uint64_t Next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        return state_;
+    }
+
+    // Uniform in [0, bound)
+    size_t Below(size_t bound) {
+        return static_cast<size_t>(Next() % bound);
+    }
+
+private:
+    uint64_t state_;
+};
+
+} // namespace test
+} // namespace serializer
+} // namespace nayan
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            ::nayan::serializer::test::ReportFailure(__FILE__, __LINE__, #condition); \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_THROWS(expression)                                                                      \
+    do {                                                                                              \
+        bool threw = false;                                                                           \
+        try {                                                                                         \
+            (void)(expression);                                                                       \
+        } catch (const std::exception&) {                                                             \
+            threw = true;                                                                             \
+        }                                                                                             \
+        if (!threw) {                                                                                 \
+            ::nayan::serializer::test::ReportFailure(__FILE__, __LINE__, "throws: " #expression);     \
+        }                                                                                             \
+    } while (0)
+
+#define RUN_TEST(name) ::nayan::serializer::test::Run(#name, name)
+
+#endif // SERIALIZATIONLIB_TEST_SUPPORT_H
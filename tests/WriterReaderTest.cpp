@@ -0,0 +1,126 @@
+// Round trips through JsonWriter/JsonReader and the generated WriteTo/ReadFrom: the writer output,
+// CountingWriter, empty optionals, string escaping and the measured sizes.
+
+#include "SampleData.h"
+#include "TestSupport.h"
+
+using namespace nayan::serializer;
+using namespace nayan::serializer::test;
+
+static void round_trips_generated_objects() {
+    Project project = MakeProject(12);
+    StdString json = SerializationUtility::Serialize(project);
+    CHECK(json == ToJson(project));
+    CHECK(SerializationUtility::MeasureSerialized(project) == json.size());
+
+    CountingWriter counter;
+    project.WriteTo(counter);
+    CHECK(counter.Count() == json.size());
+
+    Project back;
+    DeserializeStatus status = SerializationUtility::TryDeserialize(json, back);
+    CHECK(status);
+    CHECK(ToJson(back) == json);
+
+    // Through the throwing API and the reader directly
+    CHECK(ToJson(Project::Deserialize(json)) == json);
+    JsonReader reader(json.data(), json.size());
+    Project read;
+    CHECK(Project::ReadFrom(reader, read));
+    CHECK(reader.Finish() == DeserializeError::Ok);
+    CHECK(ToJson(read) == json);
+}
+
+static void writes_empty_optionals_as_null() {
+    Task task;
+    task.title = "only";
+    CHECK(ToJson(task) == "{\"title\":\"only\",\"estimate\":null,\"priority\":null,\"checkpoints\":null,\"attachment\":null,\"checksum\":null}");
+    Task back;
+    CHECK(SerializationUtility::TryDeserialize(ToJson(task), back));
+    CHECK(back.title == task.title && !back.estimate.has_value() && !back.checkpoints.has_value());
+}
+
+static void round_trips_strings_with_escapes() {
+    Random random(3);
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        StdString text(random.Below(150), 'a');
+        for (char& c : text) {
+            size_t pick = random.Below(60);
+            c = pick == 0 ? '"' : pick == 1 ? '\\' : pick == 2 ? static_cast<char>(random.Below(32)) : static_cast<char>(32 + random.Below(224));
+        }
+        StdString json;
+        JsonWriter<StdString> writer(json);
+        writer.WriteString(text.data(), text.size());
+        JsonReader reader(json.data(), json.size());
+        const char* data = nullptr;
+        size_t length = 0;
+        CHECK(reader.ReadString(data, length) == DeserializeError::Ok);
+        CHECK(StdString(data, length) == text);
+    }
+
+    const char* escaped = "\"a\\/b\\u00e9\\ud83d\\ude00\\n\"";
+    JsonReader reader(escaped, std::strlen(escaped));
+    const char* data = nullptr;
+    size_t length = 0;
+    CHECK(reader.ReadString(data, length) == DeserializeError::Ok);
+    CHECK(StdString(data, length) == "a/b\xc3\xa9\xf0\x9f\x98\x80\n");
+}
+
+template<typename T>
+static void check_measured(const T& value) {
+    StdString json = SerializationUtility::Serialize(value);
+    size_t measured = SerializationUtility::MeasureSerialized(value);
+    if (measured != json.size()) {
+        std::fprintf(stderr, "measured %zu for %s\n", measured, json.c_str());
+    }
+    CHECK(measured == json.size());
+
+    // The measured size is exactly what the buffer overload needs (plus the terminator)
+    StdString buffer(measured + 1, 'x');
+    CHECK(SerializationUtility::Serialize(value, &buffer[0], buffer.size()) == measured);
+    CHECK(std::strcmp(buffer.c_str(), json.c_str()) == 0);
+    if (measured != 0) {
+        CHECK(SerializationUtility::Serialize(value, &buffer[0], measured) == 0);
+    }
+}
+
+static void measures_what_serialize_writes() {
+    check_measured(0);
+    check_measured(std::numeric_limits<int64_t>::min());
+    check_measured(std::numeric_limits<uint64_t>::max());
+    check_measured(true);
+    check_measured(-0.0);
+    check_measured(0.1);
+    check_measured(1e300);
+    check_measured(5e-324);
+    check_measured(3.25f);
+    check_measured(StdString("plain"));
+    check_measured(StdString("quote\" backslash\\ newline\n control\x01 \xc3\xa9"));
+    check_measured(optional<int>());
+    check_measured(optional<StdString>("x"));
+    check_measured(Priority::Urgent);
+    check_measured(StdVector<double>{0.5, -1e-7, 123456789.0});
+    check_measured(StdVector<optional<int>>{1, optional<int>(), 3});
+    check_measured(StdMap<StdString, int>{{"a\"b", 1}, {"", -2}});
+    check_measured(MakeTasks(25));
+
+    Random random(9);
+    for (int round = 0; round < 200; ++round) {
+        Project project = MakeProject(random.Below(6));
+        project.budget = static_cast<double>(random.Next()) / static_cast<double>(1 + random.Below(1000000));
+        check_measured(project);
+        // The generated method agrees with the utility
+        CHECK(project.SerializedSize() == project.Serialize().size());
+    }
+    Project empty;
+    check_measured(empty);
+    CHECK(empty.SerializedSize() == empty.Serialize().size());
+}
+
+int main() {
+    RUN_TEST(round_trips_generated_objects);
+    RUN_TEST(writes_empty_optionals_as_null);
+    RUN_TEST(round_trips_strings_with_escapes);
+    RUN_TEST(measures_what_serialize_writes);
+    return nayan::serializer::test::Finish();
+}